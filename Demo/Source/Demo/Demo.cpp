@@ -1,6 +1,33 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "Demo.h"
+#include "HAL/IConsoleManager.h"
 #include "Modules/ModuleManager.h"
 
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, Demo, "Demo" );
+
+DEFINE_LOG_CATEGORY(LogHexGrid);
+DEFINE_LOG_CATEGORY(LogHexPath);
+DEFINE_LOG_CATEGORY(LogHexAnim);
+DEFINE_LOG_CATEGORY(LogBattle);
+DEFINE_LOG_CATEGORY(LogHexBench);
+
+#if HEX_LOG_SAMPLING
+int32 GHexLogSampleEvery_LogHexGrid = 1;
+int32 GHexLogSampleEvery_LogHexPath = 1;
+int32 GHexLogSampleEvery_LogHexAnim = 1;
+int32 GHexLogSampleEvery_LogBattle = 1;
+
+static FAutoConsoleVariableRef CVarHexLogSampleGrid(
+	TEXT("Hex.Log.SampleEvery.LogHexGrid"), GHexLogSampleEvery_LogHexGrid,
+	TEXT("Sampled LogHexGrid sites log one call in N (1 = every call)."));
+static FAutoConsoleVariableRef CVarHexLogSamplePath(
+	TEXT("Hex.Log.SampleEvery.LogHexPath"), GHexLogSampleEvery_LogHexPath,
+	TEXT("Sampled LogHexPath sites log one call in N (1 = every call)."));
+static FAutoConsoleVariableRef CVarHexLogSampleAnim(
+	TEXT("Hex.Log.SampleEvery.LogHexAnim"), GHexLogSampleEvery_LogHexAnim,
+	TEXT("Sampled LogHexAnim sites log one call in N (1 = every call)."));
+static FAutoConsoleVariableRef CVarHexLogSampleBattle(
+	TEXT("Hex.Log.SampleEvery.LogBattle"), GHexLogSampleEvery_LogBattle,
+	TEXT("Sampled LogBattle sites log one call in N (1 = every call)."));
+#endif
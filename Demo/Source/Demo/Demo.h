@@ -3,4 +3,51 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include <atomic>
 
+/**
+ * Log categories of the hex gameplay code.
+ * Per-call and per-tile traces are Verbose/VeryVerbose and off at runtime by default
+ * (enable with "log LogHexPath Verbose"). In Test and Shipping builds everything below
+ * Warning is compiled out, so those calls cost nothing, not even argument formatting.
+ */
+#if UE_BUILD_SHIPPING || UE_BUILD_TEST
+#define HEX_LOG_COMPILETIME_VERBOSITY Warning
+#define HEX_LOG_SAMPLING 0
+#else
+#define HEX_LOG_COMPILETIME_VERBOSITY All
+#define HEX_LOG_SAMPLING 1
+#endif
+
+DECLARE_LOG_CATEGORY_EXTERN(LogHexGrid, Log, HEX_LOG_COMPILETIME_VERBOSITY);
+DECLARE_LOG_CATEGORY_EXTERN(LogHexPath, Log, HEX_LOG_COMPILETIME_VERBOSITY);
+DECLARE_LOG_CATEGORY_EXTERN(LogHexAnim, Log, HEX_LOG_COMPILETIME_VERBOSITY);
+DECLARE_LOG_CATEGORY_EXTERN(LogBattle, Log, HEX_LOG_COMPILETIME_VERBOSITY);
+
+/** Hex.Bench results: not capped, so Test builds (where timings matter most) still print them */
+DECLARE_LOG_CATEGORY_EXTERN(LogHexBench, Log, All);
+
+#if HEX_LOG_SAMPLING
+/** Keep one call in N per call site (console: Hex.Log.SampleEvery.<Category>, 1 = every call) */
+extern DEMO_API int32 GHexLogSampleEvery_LogHexGrid;
+extern DEMO_API int32 GHexLogSampleEvery_LogHexPath;
+extern DEMO_API int32 GHexLogSampleEvery_LogHexAnim;
+extern DEMO_API int32 GHexLogSampleEvery_LogBattle;
+
+/** UE_LOG for high-frequency sites: the counter only runs while the category is active */
+#define HEX_LOG_SAMPLED(CategoryName, Verbosity, Format, ...) \
+	do \
+	{ \
+		if (UE_LOG_ACTIVE(CategoryName, Verbosity)) \
+		{ \
+			static std::atomic<uint32> HexLogSiteCalls{0}; \
+			const uint32 HexLogEvery = uint32(FMath::Max(1, GHexLogSampleEvery_##CategoryName)); \
+			if (HexLogSiteCalls.fetch_add(1, std::memory_order_relaxed) % HexLogEvery == 0) \
+			{ \
+				UE_LOG(CategoryName, Verbosity, Format, ##__VA_ARGS__); \
+			} \
+		} \
+	} while (0)
+#else
+#define HEX_LOG_SAMPLED(CategoryName, Verbosity, Format, ...) UE_LOG(CategoryName, Verbosity, Format, ##__VA_ARGS__)
+#endif
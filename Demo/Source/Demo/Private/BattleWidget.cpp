@@ -1,10 +1,12 @@
 #include "BattleWidget.h"
+#include "Demo.h"
 #include "Components/ProgressBar.h"
 #include "Components/TextBlock.h"
 #include "Components/Image.h"
 #include "Components/Button.h"
 #include "CombatComponent.h"
 #include "BattleActions.h"
+#include "HexStats.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
 #include "FloatingTextWidget.h"
@@ -259,7 +261,7 @@ void UBattleWidget::DoAction(UCombatComponent *Source, UCombatComponent *Target,
 
         const bool bSourceIsEnemy = (Source == EnemyCombat);
         const FText Msg = FText::FromString(TEXT("+3"));
-        UE_LOG(LogTemp, Log, TEXT("[FX] %s: %s"),
+        UE_LOG(LogBattle, Verbose, TEXT("[FX] %s: %s"),
                bSourceIsEnemy ? TEXT("enemy") : TEXT("player"),
                *Msg.ToString());
         SpawnFloat(bSourceIsEnemy, Msg, FLinearColor(0.25f, 1.f, 0.25f));
@@ -327,6 +329,7 @@ void UBattleWidget::DoAction(UCombatComponent *Source, UCombatComponent *Target,
 
 void UBattleWidget::StepAction()
 {
+    HEX_SCOPE(STAT_HexBattleStep, "Hex::BattleStep");
     HL_Player = INDEX_NONE;
     HL_Enemy  = INDEX_NONE;
     if (!bBattleRunning || !PlayerCombat || !EnemyCombat) { StopAutoBattle(); return; }
@@ -413,7 +416,7 @@ void UBattleWidget::GrantVictoryXP()
     {
         PlayerCombat->AddXP(VictoryXP);
         bXPGranted = true;
-        UE_LOG(LogTemp, Log, TEXT("[Battle] Granted %d XP"), VictoryXP);
+        UE_LOG(LogBattle, Log, TEXT("[Battle] Granted %d XP"), VictoryXP);
     }
 }
 
@@ -421,7 +424,7 @@ void UBattleWidget::SpawnFloat(bool bOnEnemy, const FText &T, const FLinearColor
 {
     if (!FloatingTextClass)
     {
-        UE_LOG(LogTemp, Warning, TEXT("[FX] FloatingTextClass null"));
+        UE_LOG(LogBattle, Warning, TEXT("[FX] FloatingTextClass null"));
         return;
     }
 
@@ -430,7 +433,7 @@ void UBattleWidget::SpawnFloat(bool bOnEnemy, const FText &T, const FLinearColor
     UFloatingTextWidget *W = CreateWidget<UFloatingTextWidget>(GetWorld(), FloatingTextClass);
     if (!W)
     {
-        UE_LOG(LogTemp, Warning, TEXT("[FX] CreateWidget failed"));
+        UE_LOG(LogBattle, Warning, TEXT("[FX] CreateWidget failed"));
         return;
     }
 
@@ -451,7 +454,7 @@ void UBattleWidget::SpawnFloat(bool bOnEnemy, const FText &T, const FLinearColor
     }
     else
     {
-        UE_LOG(LogTemp, Warning, TEXT("[FX] Layer null -> fallback viewport"));
+        UE_LOG(LogBattle, Warning, TEXT("[FX] Layer null -> fallback viewport"));
         W->AddToViewport(9999);
     }
 
@@ -1,18 +1,21 @@
 // DemoGameMode.cpp
 #include "DemoGameMode.h"
+#include "Demo.h"
 #include "Blueprint/UserWidget.h"
-#include "Algo/Reverse.h"
 #include "Engine/World.h"
 #include "GameFramework/PlayerController.h"
 #include "Kismet/GameplayStatics.h"
 #include "TimerManager.h"
 #include "Engine/Texture2D.h"
+#include "Components/InputComponent.h"
+#include "InputCoreTypes.h"
 #include "UObject/ConstructorHelpers.h"
 
 #include "BattleWidget.h"
 #include "HexAnimationManager.h"
 #include "HexGridManager.h"
 #include "HexPathFinder.h"
+#include "HexStats.h"
 #include "HexPawn.h"
 #include "HexTile.h"
 #include "PathView.h"
@@ -26,185 +29,6 @@
 namespace
 {
     constexpr float kSnapRetryPeriodSec = 0.05f;
-    constexpr float kPreviewThrottleSec = 0.10f;
-}
-
-namespace HexBridge
-{
-    /** BFS across existing tiles to bridge non-adjacent steps */
-    static bool BuildBridge(UHexGridManager *GM,
-                            const FHexAxialCoordinates &From,
-                            const FHexAxialCoordinates &To,
-                            TArray<FHexAxialCoordinates> &OutChain)
-    {
-        if (!GM)
-            return false;
-        if (From == To)
-        {
-            OutChain.Reset();
-            return true;
-        }
-
-        TQueue<FHexAxialCoordinates> Open;
-        TMap<FHexAxialCoordinates, FHexAxialCoordinates> Parent;
-
-        Open.Enqueue(From);
-        Parent.Add(From, From);
-
-        bool bFound = false;
-        FHexAxialCoordinates Cur;
-
-        while (Open.Dequeue(Cur))
-        {
-            const TArray<FHexAxialCoordinates> Neigh = GM->GetNeighbors(Cur);
-            for (const FHexAxialCoordinates &N : Neigh)
-            {
-                if (Parent.Contains(N))
-                    continue;
-                Parent.Add(N, Cur);
-                if (N == To)
-                {
-                    bFound = true;
-                    Cur = N;
-                    break;
-                }
-                Open.Enqueue(N);
-            }
-            if (bFound)
-                break;
-        }
-
-        if (!bFound)
-            return false;
-
-        TArray<FHexAxialCoordinates> Chain;
-        for (FHexAxialCoordinates C = Cur; !(C == From); C = Parent[C])
-        {
-            Chain.Add(C);
-        }
-        Algo::Reverse(Chain);
-        OutChain = MoveTemp(Chain);
-        return true;
-    }
-
-    /** Enforce adjacency by inserting intermediate tiles using BFS on existing tiles */
-    static void BridgePathUsingExistingTiles(UHexGridManager *GM, TArray<FHexAxialCoordinates> &Path)
-    {
-        if (!GM || Path.Num() < 2)
-            return;
-
-        TArray<FHexAxialCoordinates> Out;
-        Out.Reserve(Path.Num() * 2);
-        Out.Add(Path[0]);
-
-        for (int32 i = 1; i < Path.Num(); ++i)
-        {
-            const FHexAxialCoordinates From = Out.Last();
-            const FHexAxialCoordinates To = Path[i];
-
-            const bool bAdjacent = GM->GetNeighbors(From).Contains(To);
-            if (bAdjacent)
-            {
-                Out.Add(To);
-                continue;
-            }
-
-            TArray<FHexAxialCoordinates> Bridge;
-            if (BuildBridge(GM, From, To, Bridge) && Bridge.Num() > 0)
-            {
-                Out.Append(Bridge);
-            }
-            else
-            {
-                UE_LOG(LogTemp, Warning, TEXT("[Bridge] Impossible de relier (%d,%d)->(%d,%d) via voisins — saut ignoré"),
-                       From.Q, From.R, To.Q, To.R);
-            }
-        }
-
-        Path = MoveTemp(Out);
-    }
-}
-
-namespace Hex
-{
-    /** Doubled-Q neighbor deltas */
-    static const FHexAxialCoordinates NeighborDirs[6] =
-        {
-            {+2, 0}, {+1, -1}, {-1, -1}, {-2, 0}, {-1, +1}, {+1, +1}};
-
-    static int32 HexDistance(const FHexAxialCoordinates &A, const FHexAxialCoordinates &B)
-    {
-        const int32 dq = FMath::Abs(A.Q - B.Q);
-        const int32 dr = FMath::Abs(A.R - B.R);
-        const int32 diag = FMath::Min(dq / 2, dr);
-        const int32 remQ = dq - diag * 2;
-        const int32 remR = dr - diag;
-        return diag + remR + remQ / 2;
-    }
-
-    static bool AreNeighbors(const FHexAxialCoordinates &A, const FHexAxialCoordinates &B)
-    {
-        for (const auto &D : NeighborDirs)
-        {
-            if (A.Q + D.Q == B.Q && A.R + D.R == B.R)
-                return true;
-        }
-        return false;
-    }
-
-    static FHexAxialCoordinates StepToward(const FHexAxialCoordinates &From, const FHexAxialCoordinates &To)
-    {
-        int32 BestIdx = 0;
-        int32 BestDist = TNumericLimits<int32>::Max();
-        for (int32 i = 0; i < 6; ++i)
-        {
-            FHexAxialCoordinates C{From.Q + NeighborDirs[i].Q, From.R + NeighborDirs[i].R};
-            const int32 Dist = HexDistance(C, To);
-            if (Dist < BestDist)
-            {
-                BestDist = Dist;
-                BestIdx = i;
-            }
-        }
-        return {From.Q + NeighborDirs[BestIdx].Q, From.R + NeighborDirs[BestIdx].R};
-    }
-
-    /** Expand a path by inserting steps until all hops are adjacent (guarded) */
-    static void SanitizePath(TArray<FHexAxialCoordinates> &Path)
-    {
-        if (Path.Num() < 2)
-            return;
-
-        TArray<FHexAxialCoordinates> Out;
-        Out.Reserve(Path.Num() * 2);
-        Out.Add(Path[0]);
-
-        for (int32 i = 1; i < Path.Num(); ++i)
-        {
-            FHexAxialCoordinates Cur = Out.Last();
-            const FHexAxialCoordinates Target = Path[i];
-
-            int32 Guard = 0;
-            while (!AreNeighbors(Cur, Target) && Guard++ < 64)
-            {
-                const FHexAxialCoordinates Step = StepToward(Cur, Target);
-                Out.Add(Step);
-                Cur = Step;
-            }
-            Out.Add(Target);
-
-#if !UE_BUILD_SHIPPING
-            const int32 Jump = HexDistance(Out[Out.Num() - 2], Out.Last());
-            if (Jump > 1)
-            {
-                UE_LOG(LogTemp, Warning, TEXT("[SanitizePath] Jump=%d entre (%d,%d)->(%d,%d)"),
-                       Jump, Out[Out.Num() - 2].Q, Out[Out.Num() - 2].R, Out.Last().Q, Out.Last().R);
-            }
-#endif
-        }
-
-        Path = MoveTemp(Out);
-    }
 }
 
 void ADemoGameMode::PostLogin(APlayerController *NewPlayer)
@@ -233,6 +57,10 @@ ADemoGameMode::ADemoGameMode()
 {
     DefaultPawnClass = AHexPawn::StaticClass();
 
+    // Ticks for cursor picking once the grid exists
+    PrimaryActorTick.bCanEverTick = true;
+    PrimaryActorTick.bStartWithTickEnabled = false;
+
     GridManager = CreateDefaultSubobject<UHexGridManager>(TEXT("HexGridManager"));
     PathFinder = CreateDefaultSubobject<UHexPathFinder>(TEXT("HexPathFinder"));
 
@@ -302,7 +130,7 @@ void ADemoGameMode::BeginPlay()
     if (PathFinder && GridManager)
     {
         PathFinder->Init(GridManager);
-        UE_LOG(LogTemp, Warning, TEXT("[PathFinder] Bound Grid=%s"), *GetNameSafe(GridManager));
+        UE_LOG(LogHexPath, Log, TEXT("[PathFinder] Bound Grid=%s"), *GetNameSafe(GridManager));
     }
 
     // Optional PC override coming from BP
@@ -363,35 +191,43 @@ void ADemoGameMode::BeginPlay()
 
     if (!ensure(GridManager))
     {
-        UE_LOG(LogTemp, Error, TEXT("DemoGameMode BeginPlay: GridManager is NULL, aborting grid gen"));
+        UE_LOG(LogHexGrid, Error, TEXT("DemoGameMode BeginPlay: GridManager is NULL, aborting grid gen"));
         return;
     }
-    if (!ensure(HexTileClass))
+    if (!GridManager->IsInstanced() && !ensure(HexTileClass))
     {
-        UE_LOG(LogTemp, Error, TEXT("DemoGameMode BeginPlay: HexTileClass is NULL, aborting grid gen"));
+        UE_LOG(LogHexGrid, Error, TEXT("DemoGameMode BeginPlay: HexTileClass is NULL, aborting grid gen"));
         return;
     }
 
     // Build grid
+    GridManager->OnGridChanged.AddUObject(this, &ADemoGameMode::HandleGridChanged);
     GridManager->InitializeGrid(GridRadius, HexTileClass);
     PathFinder->Init(GridManager);
 
-    UE_LOG(LogTemp, Warning, TEXT("DemoGameMode BeginPlay : grille générée"));
-
-    // Initial pawn tile
-    InitializePawnStartTile(FHexAxialCoordinates(0, 6));
+    // Initial pawn tile (async generation places the pawn from HandleGridChanged)
+    if (!GridManager->IsGenerating())
+    {
+        UE_LOG(LogHexGrid, Log, TEXT("DemoGameMode BeginPlay : grille générée"));
+        InitializePawnStartTile(FHexAxialCoordinates(0, 6));
+    }
 
     // Mouse and UI setup
     if (APlayerController *PC = UGameplayStatics::GetPlayerController(this, 0))
     {
         PC->bShowMouseCursor = true;
-        PC->bEnableClickEvents = true;
-        PC->bEnableMouseOverEvents = true;
+        // Tiles no longer raise cursor events: picking is analytic (see UpdateCursorHover)
+        PC->bEnableClickEvents = false;
+        PC->bEnableMouseOverEvents = false;
 
         FInputModeGameAndUI Mode;
         Mode.SetHideCursorDuringCapture(false);
         Mode.SetLockMouseToViewportBehavior(EMouseLockMode::DoNotLock);
         PC->SetInputMode(Mode);
+
+        if (PC->InputComponent)
+            PC->InputComponent->BindKey(EKeys::LeftMouseButton, IE_Pressed, this, &ADemoGameMode::HandleCursorClick);
+        SetActorTickEnabled(true);
     }
 
     if (!IsValid(PathView))
@@ -407,125 +243,139 @@ void ADemoGameMode::BeginPlay()
 
 void ADemoGameMode::HandleTileClicked(AHexTile *ClickedTile)
 {
-    if (!ClickedTile || !GridManager || !PathFinder)
+    if (!ClickedTile)
+        return;
+    HandleCellClicked(ClickedTile->GetAxialCoordinates());
+}
+
+void ADemoGameMode::HandleCellClicked(const FHexAxialCoordinates &Cell)
+{
+    if (!GridManager || !PathFinder || !GridManager->HasTileAt(Cell))
         return;
 
     // Shop tiles open UI and skip pathfinding
-    if (ClickedTile->GetTileType() == EHexTileType::Shop || ClickedTile->bIsShop || ClickedTile->ActorHasTag(TEXT("Shop")))
+    const AHexTile *CellTile = GridManager->GetHexTileAt(Cell);
+    if (GridManager->GetTileType(Cell) == EHexTileType::Shop ||
+        (CellTile && (CellTile->bIsShop || CellTile->ActorHasTag(TEXT("Shop")))))
     {
-        OpenShopAt(ClickedTile);
+        OpenShopWidget();
         return;
     }
 
     AHexPawn *HexP = GetPlayerPawnTyped();
     if (!HexP)
     {
-        UE_LOG(LogTemp, Error, TEXT("HandleTileClicked: Pawn n'est pas un AHexPawn"));
+        UE_LOG(LogHexPath, Error, TEXT("HandleTileClicked: Pawn n'est pas un AHexPawn"));
         return;
     }
 
-    AHexTile *FromTile = HexP->GetCurrentTile();
-    if (!FromTile)
-{
-    HexP->SetCurrentTile(ClickedTile);
-    HexP->SetActorLocation(ClickedTile->GetActorLocation());
-    UE_LOG(LogTemp, Warning, TEXT("Affectation initiale -> (%d,%d)"),
-           ClickedTile->GetAxialCoordinates().Q, ClickedTile->GetAxialCoordinates().R);
-
-    if (ClickedTile->GetTileType() == EHexTileType::Enemy)
+    if (!HexP->HasCurrentCoords())
     {
-        StartTestBattle();
-        // keep tile as Enemy as requested
-        // ClickedTile->SetTileType(EHexTileType::Normal); // do NOT reset now
+        FVector CellLocation;
+        GridManager->GetTileWorldLocation(Cell, CellLocation);
+        HexP->SetCurrentCoords(Cell, GridManager);
+        HexP->SetActorLocation(CellLocation);
+        UE_LOG(LogHexGrid, Log, TEXT("Affectation initiale -> (%d,%d)"), Cell.Q, Cell.R);
+
+        if (GridManager->GetTileType(Cell) == EHexTileType::Enemy)
+        {
+            StartTestBattle();
+            // keep tile as Enemy as requested
+        }
+        UpdateReachableVisibility(PawnMovementPoints);
+        return;
     }
-    UpdateReachableVisibility(3);
-    return;
-}
 
+    // Clicks during a walk are ignored: the range and its budget belong to the tile the move started from
+    if (HexP->IsMoving())
+        return;
 
-    const FHexAxialCoordinates Start = FromTile->GetAxialCoordinates();
-    const FHexAxialCoordinates Goal = ClickedTile->GetAxialCoordinates();
+    const FHexAxialCoordinates Start = HexP->GetCurrentCoords();
+    const FHexAxialCoordinates Goal = Cell;
     if (Start == Goal)
         return;
 
-    UE_LOG(LogTemp, Warning, TEXT("A*: Start=(%d,%d) Goal=(%d,%d)"),
+    UE_LOG(LogHexPath, Verbose, TEXT("A*: Start=(%d,%d) Goal=(%d,%d)"),
            Start.Q, Start.R, Goal.Q, Goal.R);
-    UE_LOG(LogTemp, Warning, TEXT("A*: StartExists=%d GoalExists=%d StartNeigh=%d GoalNeigh=%d"),
-           GridManager->GetHexTileAt(Start) != nullptr,
-           GridManager->GetHexTileAt(Goal) != nullptr,
-           GridManager->GetNeighbors(Start).Num(),
-           GridManager->GetNeighbors(Goal).Num());
+    UE_LOG(LogHexPath, VeryVerbose, TEXT("A*: StartExists=%d GoalExists=%d StartNeigh=%d GoalNeigh=%d"),
+           GridManager->HasTileAt(Start),
+           GridManager->HasTileAt(Goal),
+           FMath::CountBits(GridManager->GetNeighborMaskAt(Start)),
+           FMath::CountBits(GridManager->GetNeighborMaskAt(Goal)));
 
-    TArray<FHexAxialCoordinates> Path = PathFinder->FindPath(Start, Goal);
-    HexBridge::BridgePathUsingExistingTiles(GridManager, Path);
-
-    if (Path.Num() == 0)
+    // The player's range holds the only routes the server accepts (budget, zone of control)
+    TArray<FHexAxialCoordinates> RangePath;
+    if (!RefreshReachableRange(PawnMovementPoints) ||
+        !ReachableRange.GetPathTo(*GridManager, GridManager->GetTileIndex(Goal), RangePath))
     {
-        UE_LOG(LogTemp, Warning, TEXT("A*: aucun chemin"));
+        UE_LOG(LogHexPath, Verbose, TEXT("A*: (%d,%d) hors de portée"), Goal.Q, Goal.R);
         return;
     }
-
-    HexP->StartPathFollowing(Path, GridManager);
+    HEX_VALIDATE_PATH(RangePath, TEXT("Range"), false);
+    HexP->StartPathFollowing(RangePath, GridManager);
 }
 
 void ADemoGameMode::InitializePawnStartTile(const FHexAxialCoordinates &InStartCoords)
 {
     if (!GridManager)
     {
-        UE_LOG(LogTemp, Error, TEXT("InitializePawnStartTile : GridManager null"));
+        UE_LOG(LogHexGrid, Error, TEXT("InitializePawnStartTile : GridManager null"));
         return;
     }
 
-    AHexTile *Tile = GridManager->GetHexTileAt(InStartCoords);
-    if (!Tile)
+    if (!GridManager->HasTileAt(InStartCoords))
     {
-        UE_LOG(LogTemp, Error, TEXT("InitializePawnStartTile : pas de tuile à (%d,%d)"),
+        UE_LOG(LogHexGrid, Error, TEXT("InitializePawnStartTile : pas de tuile à (%d,%d)"),
                InStartCoords.Q, InStartCoords.R);
         return;
     }
 
     if (AHexPawn *HexP = GetPlayerPawnTyped())
     {
-        HexP->SetCurrentTile(Tile);
-        UpdateReachableVisibility(3);
-        UE_LOG(LogTemp, Warning, TEXT("Pawn démarré sur (%d,%d)"),
+        HexP->SetCurrentCoords(InStartCoords, GridManager);
+        UpdateReachableVisibility(PawnMovementPoints);
+        UE_LOG(LogHexGrid, Log, TEXT("Pawn démarré sur (%d,%d)"),
                InStartCoords.Q, InStartCoords.R);
     }
     else
     {
-        UE_LOG(LogTemp, Error, TEXT("InitializePawnStartTile : pawn non HexPawn"));
+        UE_LOG(LogHexGrid, Error, TEXT("InitializePawnStartTile : pawn non HexPawn"));
     }
 }
 
+void ADemoGameMode::BuildPathPoints(const TArray<FHexAxialCoordinates> &AxialPath, TArray<FVector> &OutPoints) const
+{
+    OutPoints.Reset(AxialPath.Num());
+    FVector Location;
+    for (const auto &C : AxialPath)
+        if (GridManager->GetTileWorldLocation(C, Location))
+            OutPoints.Add(Location);
+}
+
 void ADemoGameMode::ShowPlannedPathTo(AHexTile *GoalTile)
 {
     if (!GridManager || !PathFinder || !GoalTile || !PathView)
         return;
 
     AHexPawn *P = GetPlayerPawnTyped();
-    AHexTile *StartTile = P ? P->GetCurrentTile() : nullptr;
-    if (!StartTile)
+    if (!P || !P->HasCurrentCoords())
     {
         PathView->Clear();
         return;
     }
 
-    const FHexAxialCoordinates Start = StartTile->GetAxialCoordinates();
+    const FHexAxialCoordinates Start = P->GetCurrentCoords();
     const FHexAxialCoordinates Goal = GoalTile->GetAxialCoordinates();
 
-    TArray<FHexAxialCoordinates> AxialPath = PathFinder->FindPath(Start, Goal);
-    if (AxialPath.Num() < 2)
+    TArray<FHexAxialCoordinates> AxialPath;
+    if (!GetPreviewPath(Start, Goal, AxialPath) || AxialPath.Num() < 2)
     {
         PathView->Clear();
         return;
     }
 
     TArray<FVector> Points;
-    Points.Reserve(AxialPath.Num());
-    for (const auto &C : AxialPath)
-        if (AHexTile *T = GridManager->GetHexTileAt(C))
-            Points.Add(T->GetActorLocation());
-
+    BuildPathPoints(AxialPath, Points);
     PathView->Show(Points);
 }
 
@@ -542,18 +392,24 @@ AHexPawn *ADemoGameMode::GetPlayerPawnTyped() const
 
 void ADemoGameMode::PreviewPathTo(AHexTile *GoalTile)
 {
-    if (!bPreviewEnabled || !GoalTile)
+    if (GoalTile)
+        PreviewPathToCell(GoalTile->GetAxialCoordinates());
+}
+
+void ADemoGameMode::PreviewPathToCell(const FHexAxialCoordinates &GoalCell)
+{
+    if (!bPreviewEnabled)
         return;
-    PendingGoal = GoalTile;
+    PendingGoal = GoalCell;
+    bHasPendingGoal = true;
 
-    if (!GetWorldTimerManager().IsTimerActive(PreviewThrottle))
-    {
-        GetWorldTimerManager().SetTimer(PreviewThrottle, this, &ADemoGameMode::DoPreviewTick, kPreviewThrottleSec, false);
-    }
+    // Tree lookup is O(path length): no throttle needed
+    UpdatePreview();
 }
 
-void ADemoGameMode::DoPreviewTick()
+void ADemoGameMode::UpdatePreview()
 {
+    HEX_SCOPE(STAT_HexPreview, "Hex::UpdatePreview");
     if (!PathView)
         return;
 
@@ -572,37 +428,57 @@ void ADemoGameMode::DoPreviewTick()
     if (!P)
         return;
 
-    AHexTile *StartTile = P->GetCurrentTile();
-    AHexTile *GoalTile = PendingGoal.IsValid() ? PendingGoal.Get() : nullptr;
-    if (!StartTile || !GoalTile)
+    if (!P->HasCurrentCoords() || !bHasPendingGoal)
         return;
 
-    const FHexAxialCoordinates Start = StartTile->GetAxialCoordinates();
-    const FHexAxialCoordinates Goal = GoalTile->GetAxialCoordinates();
+    const FHexAxialCoordinates Start = P->GetCurrentCoords();
+    const FHexAxialCoordinates Goal = PendingGoal;
+    const uint32 Version = GM->GetGridVersion();
 
-    if (Start == LastStart && Goal == LastGoal)
+    if (Start == LastStart && Goal == LastGoal && Version == LastPreviewGridVersion)
         return;
     LastStart = Start;
     LastGoal = Goal;
+    LastPreviewGridVersion = Version;
 
-    TArray<FHexAxialCoordinates> AxialPath = PF->FindPath(Start, Goal);
-    if (AxialPath.Num() < 2)
+    // Range or tree lookup; the tree is rebuilt only when the pawn tile or the grid changed
+    TArray<FHexAxialCoordinates> AxialPath;
+    if (!GetPreviewPath(Start, Goal, AxialPath) || AxialPath.Num() < 2)
     {
-        ClearPreview();
+        // Keep the hover goal: it may become reachable after a move or grid change
+        PathView->Clear();
         return;
     }
 
     TArray<FVector> Points;
-    Points.Reserve(AxialPath.Num());
-    for (const auto &C : AxialPath)
-        if (AHexTile *T = GM->GetHexTileAt(C))
-            Points.Add(T->GetActorLocation());
-
+    BuildPathPoints(AxialPath, Points);
     PathView->Show(Points);
 }
 
+bool ADemoGameMode::IsReachableRangeCurrentFrom(const FHexAxialCoordinates &Start) const
+{
+    return GridManager && ReachableRange.IsValid() &&
+           ReachableRange.OriginIndex == GridManager->GetTileIndex(Start) &&
+           ReachableRange.GridVersion == GridManager->GetGridVersion();
+}
+
+bool ADemoGameMode::GetPreviewPath(const FHexAxialCoordinates &Start, const FHexAxialCoordinates &Goal,
+                                   TArray<FHexAxialCoordinates> &OutPath)
+{
+    OutPath.Reset();
+    if (!GridManager || !PathFinder)
+        return false;
+
+    // The player's range holds exactly the routes a click will walk (zone of control included);
+    // tiles outside it are hidden, so there is nothing to preview there
+    if (IsReachableRangeCurrentFrom(Start))
+        return ReachableRange.GetPathTo(*GridManager, GridManager->GetTileIndex(Goal), OutPath);
+    return PathFinder->EnsurePathTree(Start) && PathFinder->GetTreePathTo(Goal, OutPath);
+}
+
 void ADemoGameMode::ClearPreview()
 {
+    bHasPendingGoal = false;
     LastStart = {INT32_MAX, INT32_MAX};
     LastGoal = {INT32_MAX, INT32_MAX};
     if (PathView)
@@ -627,7 +503,11 @@ void ADemoGameMode::OpenShopAt(AHexTile *ShopTile)
 {
     if (!ShopTile)
         return;
+    OpenShopWidget();
+}
 
+void ADemoGameMode::OpenShopWidget()
+{
     if (!ShopWidgetClass)
     {
         UE_LOG(LogTemp, Warning, TEXT("ShopWidgetClass non défini"));
@@ -651,7 +531,6 @@ void ADemoGameMode::OpenShopAt(AHexTile *ShopTile)
 void ADemoGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
     GetWorldTimerManager().ClearTimer(SnapRetryHandle);
-    GetWorldTimerManager().ClearTimer(PreviewThrottle);
 
     if (IsValid(PathView) && !PathView->IsActorBeingDestroyed())
     {
@@ -681,88 +560,124 @@ void ADemoGameMode::TrySnapPawnOnce()
     if (!P)
         return;
 
-    AHexTile *T = GridManager->GetHexTileAt(StartCoords);
-    if (!T)
+    FVector StartLocation;
+    if (!GridManager->GetTileWorldLocation(StartCoords, StartLocation))
         return;
 
     // Snap pawn and camera
-    P->SetCurrentTile(T);
-    P->SetActorLocation(T->GetActorLocation());
+    P->SetCurrentCoords(StartCoords, GridManager);
+    P->SetActorLocation(StartLocation);
     PC->bAutoManageActiveCameraTarget = false;
     PC->SetViewTarget(P);
 
     GetWorldTimerManager().ClearTimer(SnapRetryHandle);
-    UpdateReachableVisibility(3);
-    UE_LOG(LogTemp, Warning, TEXT("Snap OK sur (%d,%d)"), StartCoords.Q, StartCoords.R);
+    UpdateReachableVisibility(PawnMovementPoints);
+    UE_LOG(LogHexGrid, Log, TEXT("Snap OK sur (%d,%d)"), StartCoords.Q, StartCoords.R);
 }
 
-void ADemoGameMode::UpdateReachableVisibility(int32 MaxSteps)
+void ADemoGameMode::BuildRangeRules(int32 MovementPoints, FHexRangeRules &OutRules) const
 {
-    if (!GridManager)
+    OutRules = FHexRangeRules();
+    OutRules.Profile.MovementBudget = MovementPoints;
+    if (!bEnemyZoneOfControl || !GridManager)
         return;
 
+    // Entering an enemy tile or one next to it ends the move
+    const int32 Count = GridManager->GetTileIndexCount();
+    OutRules.ZoneOfControl.Init(false, Count);
+    for (int32 i = 0; i < Count; ++i)
+    {
+        if (!GridManager->HasTileAtIndex(i) || GridManager->GetTileTypeAtIndex(i) != EHexTileType::Enemy)
+            continue;
+        OutRules.ZoneOfControl[i] = true;
+        GridManager->ForEachNeighborIndex(i, [&](int32 N, int32 /*Dir*/) { OutRules.ZoneOfControl[N] = true; });
+    }
+}
+
+bool ADemoGameMode::RefreshReachableRange(int32 MovementPoints)
+{
+    if (!GridManager || !PathFinder)
+        return false;
+
     AHexPawn *P = GetPlayerPawnTyped();
-    if (!P)
-        return;
+    if (!P || !P->HasCurrentCoords())
+        return false;
 
-    AHexTile *StartTile = P->GetCurrentTile();
-    if (!StartTile)
-        return;
+    const int32 StartIdx = GridManager->GetTileIndex(P->GetCurrentCoords());
+    if (!GridManager->HasTileAtIndex(StartIdx))
+        return false;
 
-    const FHexAxialCoordinates Start = StartTile->GetAxialCoordinates();
+    // Nothing moved since the last call: the cached range is still right
+    ReachableBudget = MovementPoints;
+    if (StartIdx == ReachableRange.OriginIndex && MovementPoints == ReachableRange.GetBudget() &&
+        GridManager->GetGridVersion() == ReachableRange.GridVersion &&
+        bEnemyZoneOfControl == (ReachableRange.Rules.ZoneOfControl.Num() > 0))
+        return true;
 
-    // BFS borné en nombre de pas
-    TSet<FHexAxialCoordinates> Visited;
-    TMap<FHexAxialCoordinates, int32> Dist;
-    TQueue<FHexAxialCoordinates> Q;
+    FHexRangeRules Rules;
+    BuildRangeRules(MovementPoints, Rules);
+    if (!PathFinder->ComputeMovementRange(P->GetCurrentCoords(), Rules, ReachableRange))
+        return false;
+    bReachableVisibilityStale = true;
+    return true;
+}
 
-    Visited.Add(Start);
-    Dist.Add(Start, 0);
-    Q.Enqueue(Start);
+void ADemoGameMode::UpdateReachableVisibility(int32 MovementPoints)
+{
+    // Visibility is only reapplied when the range was recomputed since the last pass
+    if (!RefreshReachableRange(MovementPoints) || !bReachableVisibilityStale)
+        return;
+    bReachableVisibilityStale = false;
 
-    while (!Q.IsEmpty())
-    {
-        FHexAxialCoordinates Cur;
-        Q.Dequeue(Cur);
-        const int32 D = Dist[Cur];
-        if (D >= MaxSteps)
-            continue;
+    // The grid only touches tiles whose visibility flipped
+    const int32 Count = GridManager->GetTileIndexCount();
+    for (int32 i = 0; i < Count; ++i)
+        GridManager->SetTileVisibleAtIndex(i, ReachableRange.Contains(i));
+}
 
-        const TArray<FHexAxialCoordinates> Neigh = GridManager->GetNeighbors(Cur);
-        for (const FHexAxialCoordinates &N : Neigh)
-        {
-            if (!Visited.Contains(N))
-            {
-                Visited.Add(N);
-                Dist.Add(N, D + 1);
-                Q.Enqueue(N);
-            }
-        }
-    }
+bool ADemoGameMode::ValidatePawnMove(const AHexPawn *Pawn, const TArray<FHexAxialCoordinates> &Path)
+{
+    if (!Pawn || !PathFinder || !Pawn->HasCurrentCoords() || Path.Num() == 0)
+        return false;
+
+    // Same budget and rules for every pawn. The player's cached range doubles as the answer:
+    // no recomputation, and no visibility pass from a server check
+    if (Pawn == GetPlayerPawnTyped())
+        return RefreshReachableRange(PawnMovementPoints) && PathFinder->ValidateMove(ReachableRange, Path);
+
+    FHexRangeRules Rules;
+    BuildRangeRules(PawnMovementPoints, Rules);
+    Rules.bKeepCosts = false;
+    FHexMovementRange Range;
+    return PathFinder->ComputeMovementRange(Pawn->GetCurrentCoords(), Rules, Range) && PathFinder->ValidateMove(Range, Path);
+}
 
-    // Parcours de toute la grille via bornes connues
-    const int32 R = GridRadius;             // déjà dans le GameMode
-    for (int32 q = -2 * R; q <= 2 * R; ++q) // doubled-q
+void ADemoGameMode::HandleGridChanged(int32 TileIndex)
+{
+    if (TileIndex == INDEX_NONE)
     {
-        for (int32 r = -R; r <= R; ++r)
-        {
-            if (AHexTile *T = GridManager->GetHexTileAt({q, r}))
-            {
-                const bool bReachable = Visited.Contains({q, r});
-                T->SetActorHiddenInGame(!bReachable);
-                T->SetActorEnableCollision(bReachable);
-            }
-        }
+        // Rebuilt grid starts fully visible: force a fresh pass
+        ReachableRange = FHexMovementRange();
+        HoveredTileIndex = INDEX_NONE;
     }
+
+    // Only refresh while idle; arrival refreshes after a move
+    AHexPawn *P = GetPlayerPawnTyped();
+    if (P && TileIndex == INDEX_NONE && !P->HasCurrentCoords())
+        InitializePawnStartTile(StartCoords);
+    if (P && !P->IsMoving() && ReachableBudget != INDEX_NONE)
+        UpdateReachableVisibility(PawnMovementPoints);
+    if (bHasPendingGoal)
+        UpdatePreview();
 }
 
 void ADemoGameMode::StartTestBattle()
 {
-    UE_LOG(LogTemp, Warning, TEXT("[Battle] GM=%s  CatalogSize=%d"),
+    UE_LOG(LogBattle, Verbose, TEXT("[Battle] GM=%s  CatalogSize=%d"),
            *GetClass()->GetName(), EnemyCatalog.Num());
     for (const auto &Kvp : EnemyCatalog)
     {
-        UE_LOG(LogTemp, Warning, TEXT("[Battle] Catalog key=%s -> asset=%s"),
+        UE_LOG(LogBattle, Verbose, TEXT("[Battle] Catalog key=%s -> asset=%s"),
                *Kvp.Key.ToString(), *GetNameSafe(Kvp.Value.Get()));
     }
 
@@ -778,10 +693,10 @@ void ADemoGameMode::StartTestBattle()
     const FName EnemyId = PickRandomEnemyIdFromCatalog();
     if (EnemyId.IsNone())
     {
-        UE_LOG(LogTemp, Warning, TEXT("EnemyCatalog empty"));
+        UE_LOG(LogBattle, Warning, TEXT("EnemyCatalog empty"));
         return;
     }
-    UE_LOG(LogTemp, Warning, TEXT("[Battle] Picked id=%s"), *EnemyId.ToString());
+    UE_LOG(LogBattle, Log, TEXT("[Battle] Picked id=%s"), *EnemyId.ToString());
     // Spawn enemy with data BEFORE BeginPlay
     FVector BaseLoc = PlayerPawn ? PlayerPawn->GetActorLocation() : FVector::ZeroVector;
     FTransform X(FRotator::ZeroRotator, BaseLoc + FVector(2000, 0, 0));
@@ -805,7 +720,7 @@ void ADemoGameMode::StartTestBattle()
         }
         else
         {
-            UE_LOG(LogTemp, Warning, TEXT("EnemyCatalog has no entry for id=%s"), *EnemyId.ToString());
+            UE_LOG(LogBattle, Warning, TEXT("EnemyCatalog has no entry for id=%s"), *EnemyId.ToString());
         }
         UGameplayStatics::FinishSpawningActor(EnemyPawn, X);
         APlayerController *PC = GetWorld()->GetFirstPlayerController();
@@ -853,7 +768,7 @@ FName ADemoGameMode::PickRandomEnemyIdFromCatalog() const
     if (Keys.Num() == 0)
         return NAME_None;
     const int32 idx = FMath::RandHelper(Keys.Num());
-    UE_LOG(LogTemp, Log, TEXT("Catalog keys: %s -> pick[%d]=%s"),
+    UE_LOG(LogBattle, Verbose, TEXT("Catalog keys: %s -> pick[%d]=%s"),
            *FString::JoinBy(Keys, TEXT(","), [](const FName &N)
                             { return N.ToString(); }),
            idx, *Keys[idx].ToString());
@@ -862,14 +777,73 @@ FName ADemoGameMode::PickRandomEnemyIdFromCatalog() const
 
 void ADemoGameMode::OnPawnArrived(AHexPawn* Pawn)
 {
-    if (!Pawn) return;
-    if (AHexTile* T = Pawn->GetCurrentTile())
+    if (!Pawn || !GridManager || !Pawn->HasCurrentCoords()) return;
+
+    // New source tile: the hovered preview is re-read from a fresh tree
+    if (bHasPendingGoal)
+        UpdatePreview();
+
+    const FHexAxialCoordinates C = Pawn->GetCurrentCoords();
+    if (GridManager->GetTileType(C) == EHexTileType::Enemy)
     {
-        if (T->GetTileType() == EHexTileType::Enemy)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("[TileEvent] Enemy tile at (%d,%d)"),
-                   T->GetAxialCoordinates().Q, T->GetAxialCoordinates().R);
-            StartTestBattle();
-        }
+        UE_LOG(LogBattle, Log, TEXT("[TileEvent] Enemy tile at (%d,%d)"), C.Q, C.R);
+        StartTestBattle();
     }
+}
+
+void ADemoGameMode::Tick(float DeltaSeconds)
+{
+    Super::Tick(DeltaSeconds);
+
+    if (GridManager)
+        UpdateCursorHover();
+}
+
+int32 ADemoGameMode::GetTileIndexUnderCursor() const
+{
+    APlayerController *PC = UGameplayStatics::GetPlayerController(this, 0);
+    if (!PC || !GridManager)
+        return INDEX_NONE;
+
+    FVector RayOrigin, RayDir;
+    if (!PC->DeprojectMousePositionToWorld(RayOrigin, RayDir))
+        return INDEX_NONE;
+
+    FHexAxialCoordinates Cell;
+    if (!GridManager->PickTileFromRay(RayOrigin, RayDir, Cell))
+        return INDEX_NONE;
+
+    // Ignore cells outside the movement range (everything is visible until the pawn is placed)
+    const int32 Index = GridManager->GetTileIndex(Cell);
+    const bool bInRange = ReachableRange.IsValid() ? ReachableRange.Contains(Index) : GridManager->IsTileVisibleAtIndex(Index);
+    return bInRange ? Index : INDEX_NONE;
+}
+
+void ADemoGameMode::UpdateCursorHover()
+{
+    HEX_SCOPE(STAT_HexCursorHover, "Hex::UpdateCursorHover");
+    const int32 Index = GetTileIndexUnderCursor();
+    if (Index == HoveredTileIndex)
+        return;
+
+    if (GridManager->HasTileAtIndex(HoveredTileIndex))
+        GridManager->SetTileHighlighted(GridManager->GetTileCoords(HoveredTileIndex), false);
+    HoveredTileIndex = Index;
+
+    if (Index == INDEX_NONE)
+    {
+        ClearPreview();
+        return;
+    }
+
+    const FHexAxialCoordinates Cell = GridManager->GetTileCoords(Index);
+    GridManager->SetTileHighlighted(Cell, true);
+    PreviewPathToCell(Cell);
+}
+
+void ADemoGameMode::HandleCursorClick()
+{
+    const int32 Index = GetTileIndexUnderCursor();
+    if (Index != INDEX_NONE)
+        HandleCellClicked(GridManager->GetTileCoords(Index));
 }
\ No newline at end of file
@@ -0,0 +1,273 @@
+// HexBenchmark.cpp
+//
+// Banc d'essai du pathfinding sur grilles synthétiques (console, hors Shipping) :
+//   Hex.Bench [Radii=10+25+50+100+200] [Queries=1000] [Seed=1337] [Holes=0.1] [Obstacles=0.15] [Budget=12] [Csv=1]
+// En headless :
+//   UnrealEditor-Cmd <Projet>.uproject -game -nullrhi -unattended -nosplash -ExecCmds="Hex.Bench Queries=2000, Quit"
+// (ExecCmds sépare les commandes par des virgules : les rayons se séparent par '+')
+// Le test d'automation Hex.Pathfinding déroule aussi un banc réduit (Automation RunTests Hex).
+//
+// Charges, mêmes tirages à Seed égal :
+// - FindPath : A* complet entre deux tuiles praticables, cache désactivé, sans budget
+// - Cached   : FindPath avec le cache LRU à sa capacité par défaut, paires retirées au hasard parmi celles de FindPath
+//              (succès, échecs et expulsions mêlés, après un passage qui remplit le cache)
+// - Range    : ComputeMovementRange (budget Budget) depuis une tuile praticable
+// - Validate : chemin lu dans la portée puis ValidateMove (contrôle serveur d'un déplacement)
+// Par charge : latence p50/p99, noeuds développés (tuiles contrôlées pour Validate) et tampons alloués
+// ou agrandis par requête (UHexPathFinder::GetLastBufferAllocations), après un préchauffage des tampons.
+
+#include "HexBenchmark.h"
+#include "Demo.h"
+#include "HexGridManager.h"
+#include "HexPathFinder.h"
+#include "HexMovementRange.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if !UE_BUILD_SHIPPING
+
+namespace
+{
+	/** Retour d'une requête chronométrée */
+	struct FBenchQuery
+	{
+		bool  bFound = false;
+		int32 Nodes = 0;
+		int32 Allocs = 0;
+	};
+
+	/** Mesures d'une charge ; Micros est réservé d'avance */
+	struct FBenchSamples
+	{
+		TArray<double> Micros;
+		int64 Nodes = 0;
+		int64 Allocs = 0;
+		int32 Found = 0;
+
+		explicit FBenchSamples(int32 Queries) { Micros.Reserve(Queries); }
+
+		double Percentile(double P) const
+		{
+			if (Micros.Num() == 0)
+				return 0.0;
+			const int32 Rank = FMath::Clamp(FMath::CeilToInt(P * Micros.Num()) - 1, 0, Micros.Num() - 1);
+			return Micros[Rank];
+		}
+	};
+
+	/** Chronomètre une requête */
+	template <typename FuncType>
+	void Measure(FBenchSamples& Out, FuncType&& Fn)
+	{
+		const uint64 Start = FPlatformTime::Cycles64();
+		const FBenchQuery R = Fn();
+		const uint64 End = FPlatformTime::Cycles64();
+		Out.Micros.Add(FPlatformTime::ToSeconds64(End - Start) * 1e6);
+		Out.Nodes += R.Nodes;
+		Out.Allocs += R.Allocs;
+		Out.Found += R.bFound ? 1 : 0;
+	}
+
+	FHexBenchRow MakeRow(const TCHAR* Workload, int32 Radius, int32 Tiles, FBenchSamples& S)
+	{
+		S.Micros.Sort();
+		const int32 N = FMath::Max(1, S.Micros.Num());
+
+		FHexBenchRow Row;
+		Row.Radius = Radius;
+		Row.Tiles = Tiles;
+		Row.Workload = Workload;
+		Row.Queries = S.Micros.Num();
+		Row.P50Us = S.Percentile(0.50);
+		Row.P99Us = S.Percentile(0.99);
+		Row.NodesPerQuery = double(S.Nodes) / N;
+		Row.AllocsPerQuery = double(S.Allocs) / N;
+		Row.Found = S.Found;
+		return Row;
+	}
+
+	void RunRadius(const FHexBenchSettings& Settings, int32 Radius, UHexGridManager& Grid, UHexPathFinder& PathFinder, TArray<FHexBenchRow>& OutRows)
+	{
+		const int32 Seed = Settings.Seed + Radius;
+		Grid.BuildSyntheticGrid(Radius, Settings.HoleChance, Settings.ObstacleChance, Seed);
+
+		// Tuiles praticables : départs et arrivées des requêtes
+		TArray<FHexAxialCoordinates> Walkable;
+		for (int32 Index = 0; Index < Grid.GetTileIndexCount(); ++Index)
+			if (Grid.HasTileAtIndex(Index) && Grid.GetTileMoveCostAtIndex(Index) > 0)
+				Walkable.Add(Grid.GetTileCoords(Index));
+		if (Walkable.Num() < 2)
+			return;
+
+		const int32 Queries = Settings.Queries;
+		const int32 Warmup = FMath::Min(Queries, 32);
+		FRandomStream Rng(Seed);
+		TArray<TPair<FHexAxialCoordinates, FHexAxialCoordinates>> Pairs;
+		Pairs.Reserve(Warmup + Queries);
+		for (int32 i = 0; i < Warmup + Queries; ++i)
+			Pairs.Emplace(Walkable[Rng.RandHelper(Walkable.Num())], Walkable[Rng.RandHelper(Walkable.Num())]);
+
+		PathFinder.PathCacheCapacity = 0;
+		PathFinder.ResetPathCache();
+
+		TArray<FHexAxialCoordinates> Path;
+		Path.Reserve(Grid.GetTileIndexCount());
+		FHexMovementRange Range;
+		FHexRangeRules Rules;
+		Rules.Profile.MovementBudget = Settings.Budget;
+		TArray<int32> ReachableScratch;
+		ReachableScratch.Reserve(Grid.GetTileIndexCount());
+
+		FBenchSamples FindSamples(Queries), CachedSamples(Queries), RangeSamples(Queries), ValidateSamples(Queries);
+
+		// --- FindPath ---
+		PathFinder.MovementBudget = 0;
+		for (int32 i = 0; i < Warmup; ++i)
+			PathFinder.FindPathInto(Pairs[i].Key, Pairs[i].Value, Path);
+		for (int32 i = Warmup; i < Warmup + Queries; ++i)
+		{
+			Measure(FindSamples, [&]
+			{
+				const bool bFound = PathFinder.FindPathInto(Pairs[i].Key, Pairs[i].Value, Path);
+				return FBenchQuery{bFound, PathFinder.GetLastNodesExpanded(), PathFinder.GetLastBufferAllocations()};
+			});
+		}
+
+		// --- Cached : régime établi du cache par défaut, emplacements et tampons déjà dimensionnés ---
+		PathFinder.PathCacheCapacity = GetDefault<UHexPathFinder>()->PathCacheCapacity;
+		PathFinder.ResetPathCache();
+		for (int32 i = Warmup; i < Warmup + Queries; ++i)
+			PathFinder.FindPathInto(Pairs[i].Key, Pairs[i].Value, Path);
+		for (int32 q = 0; q < Queries; ++q)
+		{
+			const int32 i = Warmup + Rng.RandHelper(Queries);
+			Measure(CachedSamples, [&]
+			{
+				const bool bFound = PathFinder.FindPathInto(Pairs[i].Key, Pairs[i].Value, Path);
+				return FBenchQuery{bFound, PathFinder.GetLastNodesExpanded(), PathFinder.GetLastBufferAllocations()};
+			});
+		}
+		PathFinder.PathCacheCapacity = 0;
+		PathFinder.ResetPathCache();
+
+		// --- Range ---
+		for (int32 i = 0; i < Warmup; ++i)
+			PathFinder.ComputeMovementRange(Pairs[i].Key, Rules, Range);
+		for (int32 i = Warmup; i < Warmup + Queries; ++i)
+		{
+			Measure(RangeSamples, [&]
+			{
+				const bool bFound = PathFinder.ComputeMovementRange(Pairs[i].Key, Rules, Range);
+				return FBenchQuery{bFound, PathFinder.GetLastNodesExpanded(), PathFinder.GetLastBufferAllocations()};
+			});
+		}
+
+		// --- Validate : portée calculée hors mesure, cible tirée parmi les cases atteintes ---
+		for (int32 i = Warmup; i < Warmup + Queries; ++i)
+		{
+			PathFinder.ComputeMovementRange(Pairs[i].Key, Rules, Range);
+			ReachableScratch.Reset();
+			for (TConstSetBitIterator<> It(Range.Reachable); It; ++It)
+				ReachableScratch.Add(It.GetIndex());
+			const int32 Target = ReachableScratch[Rng.RandHelper(ReachableScratch.Num())];
+
+			Measure(ValidateSamples, [&]
+			{
+				const void* PathData = Path.GetData();
+				const bool bValid = Range.GetPathTo(Grid, Target, Path) && PathFinder.ValidateMove(Range, Path);
+				return FBenchQuery{bValid, Path.Num(), Path.GetData() != PathData ? 1 : 0};
+			});
+		}
+
+		const int32 Tiles = Walkable.Num();
+		OutRows.Add(MakeRow(TEXT("FindPath"), Radius, Tiles, FindSamples));
+		OutRows.Add(MakeRow(TEXT("Cached"), Radius, Tiles, CachedSamples));
+		OutRows.Add(MakeRow(TEXT("Range"), Radius, Tiles, RangeSamples));
+		OutRows.Add(MakeRow(TEXT("Validate"), Radius, Tiles, ValidateSamples));
+	}
+
+	void RunHexBenchCommand(const TArray<FString>& Args)
+	{
+		const FString Cmd = FString::Join(Args, TEXT(" "));
+		FHexBenchSettings Settings;
+
+		FString RadiiText;
+		if (FParse::Value(*Cmd, TEXT("Radii="), RadiiText))
+		{
+			TArray<FString> Parts;
+			RadiiText.Replace(TEXT("+"), TEXT(",")).ParseIntoArray(Parts, TEXT(","));
+			Settings.Radii.Reset();
+			for (const FString& P : Parts)
+				Settings.Radii.Add(FMath::Clamp(FCString::Atoi(*P), 1, 1000));
+		}
+		FParse::Value(*Cmd, TEXT("Queries="), Settings.Queries);
+		FParse::Value(*Cmd, TEXT("Seed="), Settings.Seed);
+		FParse::Value(*Cmd, TEXT("Holes="), Settings.HoleChance);
+		FParse::Value(*Cmd, TEXT("Obstacles="), Settings.ObstacleChance);
+		FParse::Value(*Cmd, TEXT("Budget="), Settings.Budget);
+		FParse::Bool(*Cmd, TEXT("Csv="), Settings.bWriteCsv);
+
+		UE_LOG(LogHexBench, Display, TEXT("[HexBench] seed=%d queries=%d holes=%.2f obstacles=%.2f budget=%d"),
+		       Settings.Seed, Settings.Queries, Settings.HoleChance, Settings.ObstacleChance, Settings.Budget);
+
+		TArray<FHexBenchRow> Rows;
+		HexBench::Run(Settings, Rows);
+		for (const FHexBenchRow& Row : Rows)
+			UE_LOG(LogHexBench, Display, TEXT("[HexBench] %s"), *HexBench::FormatRow(Row));
+
+		if (Settings.bWriteCsv)
+		{
+			TArray<FString> CsvLines;
+			CsvLines.Add(TEXT("radius,tiles,workload,queries,p50_us,p99_us,nodes_per_query,allocs_per_query,found"));
+			for (const FHexBenchRow& Row : Rows)
+				CsvLines.Add(FString::Printf(TEXT("%d,%d,%s,%d,%.3f,%.3f,%.2f,%.3f,%d"), Row.Radius, Row.Tiles, Row.Workload,
+				                             Row.Queries, Row.P50Us, Row.P99Us, Row.NodesPerQuery, Row.AllocsPerQuery, Row.Found));
+
+			const FString CsvPath = FPaths::ProjectSavedDir() / TEXT("HexBench") /
+			                        FString::Printf(TEXT("HexBench-%s.csv"), *FDateTime::Now().ToString());
+			if (FFileHelper::SaveStringArrayToFile(CsvLines, *CsvPath))
+				UE_LOG(LogHexBench, Display, TEXT("[HexBench] Results written to %s"), *CsvPath);
+			else
+				UE_LOG(LogHexBench, Warning, TEXT("[HexBench] Could not write %s"), *CsvPath);
+		}
+	}
+
+	FAutoConsoleCommand HexBenchCommand(
+		TEXT("Hex.Bench"),
+		TEXT("Pathfinding benchmark on synthetic grids. ")
+		TEXT("Hex.Bench [Radii=10+25+50+100+200] [Queries=1000] [Seed=1337] [Holes=0.1] [Obstacles=0.15] [Budget=12] [Csv=1]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunHexBenchCommand));
+}
+
+void HexBench::Run(const FHexBenchSettings& InSettings, TArray<FHexBenchRow>& OutRows)
+{
+	FHexBenchSettings Settings = InSettings;
+	Settings.Queries = FMath::Max(1, Settings.Queries);
+	Settings.Budget = FMath::Max(1, Settings.Budget);
+
+	// Composants hors acteur : ni monde, ni rendu, ni traces
+	TStrongObjectPtr<UHexGridManager> Grid(NewObject<UHexGridManager>(GetTransientPackage()));
+	TStrongObjectPtr<UHexPathFinder> PathFinder(NewObject<UHexPathFinder>(GetTransientPackage()));
+	PathFinder->Init(Grid.Get());
+
+	for (const int32 Radius : Settings.Radii)
+		RunRadius(Settings, Radius, *Grid, *PathFinder, OutRows);
+
+	PathFinder->Init(nullptr);
+}
+
+FString HexBench::FormatRow(const FHexBenchRow& Row)
+{
+	return FString::Printf(TEXT("R=%3d tiles=%6d %-8s p50=%9.2fus p99=%9.2fus nodes=%9.1f allocs=%6.2f found=%d/%d"),
+	                       Row.Radius, Row.Tiles, Row.Workload, Row.P50Us, Row.P99Us, Row.NodesPerQuery,
+	                       Row.AllocsPerQuery, Row.Found, Row.Queries);
+}
+
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+/** Réglages d'un banc (Hex.Bench, test Hex.Pathfinding) ; mêmes tirages à Seed égal */
+struct FHexBenchSettings
+{
+	TArray<int32> Radii = {10, 25, 50, 100, 200};
+	int32 Queries = 1000;
+	int32 Seed = 1337;
+	float HoleChance = 0.1f;
+	float ObstacleChance = 0.15f;
+	int32 Budget = 12;
+	bool  bWriteCsv = true;
+};
+
+/** Résultat d'une charge sur un rayon */
+struct FHexBenchRow
+{
+	int32        Radius = 0;
+	int32        Tiles = 0;       // tuiles praticables
+	const TCHAR* Workload = TEXT("");
+	int32        Queries = 0;
+	double       P50Us = 0.0;
+	double       P99Us = 0.0;
+	double       NodesPerQuery = 0.0;
+	double       AllocsPerQuery = 0.0; // tampons (ré)alloués par requête, après préchauffage
+	int32        Found = 0;
+};
+
+namespace HexBench
+{
+	/** Déroule les charges FindPath, Cached, Range et Validate sur chaque rayon (game thread) */
+	void Run(const FHexBenchSettings& Settings, TArray<FHexBenchRow>& OutRows);
+
+	/** Une ligne lisible (journal, rapport d'automation) */
+	FString FormatRow(const FHexBenchRow& Row);
+}
+
+#endif // !UE_BUILD_SHIPPING
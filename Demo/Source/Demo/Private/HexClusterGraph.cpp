@@ -0,0 +1,457 @@
+#include "HexClusterGraph.h"
+#include "HexGridManager.h"
+#include "Algo/Reverse.h"
+
+namespace
+{
+	struct FOpenLess
+	{
+		template <typename T>
+		FORCEINLINE bool operator()(const T& A, const T& B) const
+		{
+			return A.F < B.F || (A.F == B.F && A.H < B.H);
+		}
+	};
+
+	FORCEINLINE int32 FloorDiv(int32 A, int32 B)
+	{
+		return (A >= 0) ? A / B : -((-A + B - 1) / B);
+	}
+
+	/** Union-find minimal pour regrouper les passages d'une frontière en segments contigus */
+	int32 FindRoot(TArray<int32>& Parent, int32 I)
+	{
+		while (Parent[I] != I)
+		{
+			Parent[I] = Parent[Parent[I]];
+			I = Parent[I];
+		}
+		return I;
+	}
+}
+
+void FHexClusterGraph::SetClusterSize(int32 InSize)
+{
+	InSize = FMath::Max(2, InSize);
+	if (InSize != ClusterSize)
+	{
+		ClusterSize = InSize;
+		bNeedsPartition = true;
+	}
+}
+
+void FHexClusterGraph::MarkTileChanged(int32 TileIndex)
+{
+	if (TileIndex == INDEX_NONE || !TileCluster.IsValidIndex(TileIndex) || TileCluster[TileIndex] == INDEX_NONE)
+	{
+		// Rebuild complet (ou tuile inconnue du découpage) : présence des tuiles peut-être changée
+		bNeedsPartition = true;
+		return;
+	}
+	DirtyClusters.Add(TileCluster[TileIndex]);
+}
+
+uint32 FHexClusterGraph::BeginGeneration(TArray<FSearchNode>& Nodes, uint32& Generation, int32 Count)
+{
+	if (Nodes.Num() < Count)
+		Nodes.SetNum(Count);
+	if (++Generation == 0)
+	{
+		for (FSearchNode& N : Nodes)
+			N.Generation = 0;
+		Generation = 1;
+	}
+	Heap.Reset();
+	return Generation;
+}
+
+void FHexClusterGraph::Partition(const UHexGridManager& Grid)
+{
+	const int32 Count = Grid.GetTileIndexCount();
+	TileCluster.Init(INDEX_NONE, Count);
+	Clusters.Reset();
+	Borders.Reset();
+	DirtyClusters.Reset();
+
+	TMap<FIntPoint, int32> ClusterByKey;
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		if (!Grid.HasTileAtIndex(Index))
+			continue;
+
+		// Labels doubled-q : Q toujours pair, q axial = Q / 2
+		const FHexAxialCoordinates C = Grid.GetTileCoords(Index);
+		const FIntPoint Key(FloorDiv(FloorDiv(C.Q, 2), ClusterSize), FloorDiv(C.R, ClusterSize));
+		int32& Id = ClusterByKey.FindOrAdd(Key, INDEX_NONE);
+		if (Id == INDEX_NONE)
+			Id = Clusters.AddDefaulted();
+		Clusters[Id].Tiles.Add(Index);
+		TileCluster[Index] = Id;
+	}
+
+	for (int32 Id = 0; Id < Clusters.Num(); ++Id)
+	{
+		for (const int32 Tile : Clusters[Id].Tiles)
+		{
+			Grid.ForEachNeighborIndex(Tile, [&](int32 NIdx, int32 /*Dir*/)
+			{
+				if (TileCluster[NIdx] != Id)
+					Clusters[Id].Neighbors.AddUnique(TileCluster[NIdx]);
+			});
+		}
+		DirtyClusters.Add(Id);
+	}
+
+	bNeedsPartition = false;
+}
+
+void FHexClusterGraph::ComputeBorder(const UHexGridManager& Grid, int32 Low, int32 High)
+{
+	TArray<FTransition>& Out = Borders.FindOrAdd(BorderKey(Low, High));
+	Out.Reset();
+
+	// Passages franchissables dans les deux sens entre les deux clusters
+	TArray<FTransition> Crossings;
+	for (const int32 Tile : Clusters[Low].Tiles)
+	{
+		if (Grid.GetTileMoveCostAtIndex(Tile) == 0)
+			continue;
+		Grid.ForEachNeighborIndex(Tile, [&](int32 NIdx, int32 /*Dir*/)
+		{
+			if (TileCluster[NIdx] == High && Grid.GetTileMoveCostAtIndex(NIdx) > 0)
+				Crossings.Add(FTransition{Tile, NIdx});
+		});
+	}
+	if (Crossings.Num() == 0)
+		return;
+
+	// Segments contigus : deux passages sont liés s'ils partagent ou touchent une tuile du même côté
+	TArray<int32> Parent;
+	Parent.SetNumUninitialized(Crossings.Num());
+	for (int32 i = 0; i < Crossings.Num(); ++i)
+		Parent[i] = i;
+	for (int32 i = 0; i < Crossings.Num(); ++i)
+	{
+		for (int32 j = i + 1; j < Crossings.Num(); ++j)
+		{
+			const bool bLinked = Crossings[i].Low == Crossings[j].Low || Crossings[i].High == Crossings[j].High ||
+			                     Grid.AxialDistance(Grid.GetTileCoords(Crossings[i].Low), Grid.GetTileCoords(Crossings[j].Low)) == 1;
+			if (bLinked)
+				Parent[FindRoot(Parent, i)] = FindRoot(Parent, j);
+		}
+	}
+
+	// Une transition par segment : le passage du milieu (ordre d'index stable)
+	TMap<int32, TArray<int32>> Segments;
+	for (int32 i = 0; i < Crossings.Num(); ++i)
+		Segments.FindOrAdd(FindRoot(Parent, i)).Add(i);
+	for (auto& Pair : Segments)
+	{
+		TArray<int32>& Members = Pair.Value;
+		Members.Sort([&](int32 A, int32 B)
+		{
+			return Crossings[A].Low != Crossings[B].Low ? Crossings[A].Low < Crossings[B].Low : Crossings[A].High < Crossings[B].High;
+		});
+		Out.Add(Crossings[Members[Members.Num() / 2]]);
+	}
+}
+
+void FHexClusterGraph::GatherEntrances(int32 ClusterId, TArray<int32>& OutEntrances) const
+{
+	OutEntrances.Reset();
+	for (const int32 N : Clusters[ClusterId].Neighbors)
+	{
+		if (const TArray<FTransition>* Border = Borders.Find(BorderKey(ClusterId, N)))
+		{
+			for (const FTransition& T : *Border)
+				OutEntrances.AddUnique(ClusterId < N ? T.Low : T.High);
+		}
+	}
+	OutEntrances.Sort();
+}
+
+void FHexClusterGraph::SearchInCluster(const UHexGridManager& Grid, int32 Source, int32 Goal, bool bReverse)
+{
+	const uint32 Gen = BeginGeneration(TileNodes, TileGeneration, Grid.GetTileIndexCount());
+	const int32 ClusterId = TileCluster[Source];
+	const FHexAxialCoordinates GoalCoords = Goal != INDEX_NONE ? Grid.GetTileCoords(Goal) : FHexAxialCoordinates();
+	const int32 MinCost = Grid.GetMinMoveCost();
+	auto H = [&](int32 Tile) { return Goal != INDEX_NONE ? Grid.AxialDistance(Grid.GetTileCoords(Tile), GoalCoords) * MinCost : 0; };
+
+	TileNodes[Source] = FSearchNode{0, INDEX_NONE, Gen, false};
+	Heap.HeapPush(FOpenEntry{H(Source), H(Source), Source}, FOpenLess());
+
+	while (Heap.Num() > 0)
+	{
+		FOpenEntry Top;
+		Heap.HeapPop(Top, FOpenLess(), EAllowShrinking::No);
+		FSearchNode& Cur = TileNodes[Top.Index];
+		if (Cur.bClosed)
+			continue;
+		Cur.bClosed = true;
+		if (Top.Index == Goal)
+			return;
+
+		const int32 CurIdx = Top.Index;
+		const int32 CurG = Cur.G;
+		// Sens inverse : le pas V -> Cur coûte l'entrée dans Cur (infranchissable : rien n'y mène)
+		const int32 ReverseStep = Grid.GetTileMoveCostAtIndex(CurIdx);
+		if (bReverse && ReverseStep == 0)
+			continue;
+
+		Grid.ForEachNeighborIndex(CurIdx, [&](int32 NIdx, int32 /*Dir*/)
+		{
+			if (TileCluster[NIdx] != ClusterId)
+				return;
+			const uint8 Enter = Grid.GetTileMoveCostAtIndex(NIdx);
+			if (Enter == 0)
+				return;
+
+			const int32 TentativeG = CurG + (bReverse ? ReverseStep : Enter);
+			FSearchNode& N = TileNodes[NIdx];
+			if (N.Generation != Gen)
+			{
+				N.Generation = Gen;
+				N.bClosed = false;
+			}
+			else if (N.bClosed || TentativeG >= N.G)
+			{
+				return;
+			}
+			N.G = TentativeG;
+			N.Parent = CurIdx;
+			const int32 NH = H(NIdx);
+			Heap.HeapPush(FOpenEntry{TentativeG + NH, NH, NIdx}, FOpenLess());
+		});
+	}
+}
+
+void FHexClusterGraph::ComputeIntra(const UHexGridManager& Grid, int32 ClusterId)
+{
+	FCluster& Cluster = Clusters[ClusterId];
+	Cluster.Intra.Reset();
+	for (const int32 From : Cluster.Entrances)
+	{
+		SearchInCluster(Grid, From, INDEX_NONE, /*bReverse*/ false);
+		for (const int32 To : Cluster.Entrances)
+		{
+			if (To != From && IsReached(To))
+				Cluster.Intra.Add(FIntraEdge{From, To, TileNodes[To].G});
+		}
+	}
+}
+
+void FHexClusterGraph::RebuildAdjacency(const UHexGridManager& Grid)
+{
+	NodeOfTile.Reset();
+	NodeTiles.Reset();
+	for (const FCluster& Cluster : Clusters)
+	{
+		for (const int32 Tile : Cluster.Entrances)
+		{
+			NodeOfTile.Add(Tile, NodeTiles.Num());
+			NodeTiles.Add(Tile);
+		}
+	}
+
+	NodeEdges.SetNum(NodeTiles.Num());
+	for (TArray<FEdge>& Edges : NodeEdges)
+		Edges.Reset();
+
+	for (const FCluster& Cluster : Clusters)
+		for (const FIntraEdge& E : Cluster.Intra)
+			NodeEdges[NodeOfTile[E.From]].Add(FEdge{NodeOfTile[E.To], E.Cost});
+
+	for (const auto& Pair : Borders)
+	{
+		for (const FTransition& T : Pair.Value)
+		{
+			const int32 A = NodeOfTile[T.Low];
+			const int32 B = NodeOfTile[T.High];
+			NodeEdges[A].Add(FEdge{B, Grid.GetTileMoveCostAtIndex(T.High)});
+			NodeEdges[B].Add(FEdge{A, Grid.GetTileMoveCostAtIndex(T.Low)});
+		}
+	}
+	bAdjacencyDirty = false;
+}
+
+void FHexClusterGraph::Update(const UHexGridManager& Grid)
+{
+	if (bNeedsPartition || TileCluster.Num() != Grid.GetTileIndexCount())
+		Partition(Grid);
+	if (DirtyClusters.Num() == 0)
+	{
+		if (bAdjacencyDirty)
+			RebuildAdjacency(Grid);
+		return;
+	}
+
+	// Frontières touchant un cluster sale, une fois par paire : entre deux clusters sales, le plus petit Id s'en charge
+	for (const int32 Id : DirtyClusters)
+		for (const int32 N : Clusters[Id].Neighbors)
+			if (N > Id || !DirtyClusters.Contains(N))
+				ComputeBorder(Grid, FMath::Min(Id, N), FMath::Max(Id, N));
+
+	// Entrées : clusters sales + voisins ; coûts intra seulement si sale ou si ses entrées ont bougé
+	TSet<int32> Touched = DirtyClusters;
+	for (const int32 Id : DirtyClusters)
+		Touched.Append(Clusters[Id].Neighbors);
+
+	TArray<int32> NewEntrances;
+	for (const int32 Id : Touched)
+	{
+		GatherEntrances(Id, NewEntrances);
+		if (!DirtyClusters.Contains(Id) && NewEntrances == Clusters[Id].Entrances)
+			continue;
+		Clusters[Id].Entrances = NewEntrances;
+		ComputeIntra(Grid, Id);
+	}
+
+	DirtyClusters.Reset();
+	RebuildAdjacency(Grid);
+}
+
+bool FHexClusterGraph::FindPath(const UHexGridManager& Grid, const FHexAxialCoordinates& Start, const FHexAxialCoordinates& Goal,
+                                int32 Budget, TArray<FHexAxialCoordinates>& OutPath)
+{
+	OutPath.Reset();
+	LastAbstractExpanded = 0;
+
+	const int32 StartTile = Grid.GetTileIndex(Start);
+	const int32 GoalTile = Grid.GetTileIndex(Goal);
+	if (!Grid.HasTileAtIndex(StartTile) || !Grid.HasTileAtIndex(GoalTile))
+		return false;
+	if (StartTile == GoalTile)
+	{
+		OutPath.Add(Start);
+		return true;
+	}
+
+	Update(Grid);
+
+	// Raccordement temporaire : Start -> entrées de son cluster, entrées du cluster du but -> Goal
+	const int32 NodeCount = NodeTiles.Num();
+	const int32 StartNode = NodeCount;
+	const int32 GoalNode = NodeCount + 1;
+
+	TArray<FEdge, TInlineAllocator<32>> StartEdges;
+	SearchInCluster(Grid, StartTile, INDEX_NONE, /*bReverse*/ false);
+	for (const int32 E : Clusters[TileCluster[StartTile]].Entrances)
+		if (IsReached(E))
+			StartEdges.Add(FEdge{NodeOfTile[E], TileNodes[E].G});
+	if (TileCluster[StartTile] == TileCluster[GoalTile] && IsReached(GoalTile))
+		StartEdges.Add(FEdge{GoalNode, TileNodes[GoalTile].G});
+
+	TMap<int32, int32, TInlineSetAllocator<32>> GoalEdges; // noeud -> coût jusqu'au but
+	SearchInCluster(Grid, GoalTile, INDEX_NONE, /*bReverse*/ true);
+	for (const int32 E : Clusters[TileCluster[GoalTile]].Entrances)
+		if (IsReached(E))
+			GoalEdges.Add(NodeOfTile[E], TileNodes[E].G);
+
+	// A* abstrait
+	const uint32 Gen = BeginGeneration(AbsNodes, AbsGeneration, NodeCount + 2);
+	const FHexAxialCoordinates GoalCoords = Grid.GetTileCoords(GoalTile);
+	const int32 MinCost = Grid.GetMinMoveCost();
+	auto TileOf = [&](int32 Node) { return Node == StartNode ? StartTile : Node == GoalNode ? GoalTile : NodeTiles[Node]; };
+	auto H = [&](int32 Node) { return Grid.AxialDistance(Grid.GetTileCoords(TileOf(Node)), GoalCoords) * MinCost; };
+
+	AbsNodes[StartNode] = FSearchNode{0, INDEX_NONE, Gen, false};
+	Heap.HeapPush(FOpenEntry{H(StartNode), H(StartNode), StartNode}, FOpenLess());
+
+	bool bFound = false;
+	while (Heap.Num() > 0)
+	{
+		FOpenEntry Top;
+		Heap.HeapPop(Top, FOpenLess(), EAllowShrinking::No);
+		FSearchNode& Cur = AbsNodes[Top.Index];
+		if (Cur.bClosed)
+			continue;
+		Cur.bClosed = true;
+		++LastAbstractExpanded;
+		if (Top.Index == GoalNode)
+		{
+			bFound = true;
+			break;
+		}
+
+		const int32 CurNode = Top.Index;
+		const int32 CurG = Cur.G;
+		auto Relax = [&](int32 To, int32 Cost)
+		{
+			const int32 TentativeG = CurG + Cost;
+			FSearchNode& N = AbsNodes[To];
+			if (N.Generation != Gen)
+			{
+				N.Generation = Gen;
+				N.bClosed = false;
+			}
+			else if (N.bClosed || TentativeG >= N.G)
+			{
+				return;
+			}
+			N.G = TentativeG;
+			N.Parent = CurNode;
+			const int32 NH = H(To);
+			Heap.HeapPush(FOpenEntry{TentativeG + NH, NH, To}, FOpenLess());
+		};
+
+		if (CurNode == StartNode)
+		{
+			for (const FEdge& E : StartEdges)
+				Relax(E.To, E.Cost);
+			continue;
+		}
+		for (const FEdge& E : NodeEdges[CurNode])
+			Relax(E.To, E.Cost);
+		if (const int32* ToGoal = GoalEdges.Find(CurNode))
+			Relax(GoalNode, *ToGoal);
+	}
+	if (!bFound)
+		return false;
+
+	// Points de passage abstraits (tuiles), du départ au but
+	TArray<int32, TInlineAllocator<64>> Waypoints;
+	for (int32 Node = GoalNode; Node != INDEX_NONE; Node = AbsNodes[Node].Parent)
+		Waypoints.Add(TileOf(Node));
+	Algo::Reverse(Waypoints);
+
+	// Raffinement segment par segment ; on s'arrête dès que le budget est dépassé
+	TArray<int32, TInlineAllocator<64>> Tiles;
+	TArray<int32, TInlineAllocator<64>> Costs; // coût cumulé à chaque tuile
+	Tiles.Add(StartTile);
+	Costs.Add(0);
+	for (int32 w = 1; w < Waypoints.Num() && !(Budget > 0 && Costs.Last() > Budget); ++w)
+	{
+		const int32 From = Waypoints[w - 1];
+		const int32 To = Waypoints[w];
+		if (TileCluster[From] != TileCluster[To])
+		{
+			// Transition : deux tuiles adjacentes de part et d'autre d'une frontière
+			Tiles.Add(To);
+			Costs.Add(Costs.Last() + Grid.GetTileMoveCostAtIndex(To));
+			continue;
+		}
+
+		SearchInCluster(Grid, From, To, /*bReverse*/ false);
+		if (!IsReached(To))
+			return false; // ne devrait pas arriver : coûts intra à jour
+
+		const int32 First = Tiles.Num();
+		for (int32 T = To; T != From; T = TileNodes[T].Parent)
+			Tiles.Add(T);
+		Algo::Reverse(Tiles.GetData() + First, Tiles.Num() - First);
+		for (int32 i = First; i < Tiles.Num(); ++i)
+			Costs.Add(Costs[First - 1] + TileNodes[Tiles[i]].G);
+	}
+
+	// Même troncature que UHexPathFinder : dernière tuile payable
+	int32 Len = Tiles.Num();
+	if (Budget > 0)
+		while (Len > 1 && Costs[Len - 1] > Budget)
+			--Len;
+
+	OutPath.SetNumUninitialized(Len);
+	for (int32 i = 0; i < Len; ++i)
+		OutPath[i] = Grid.GetTileCoords(Tiles[i]);
+	return true;
+}
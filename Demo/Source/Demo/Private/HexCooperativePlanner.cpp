@@ -0,0 +1,315 @@
+#include "HexCooperativePlanner.h"
+#include "HexGridSnapshot.h"
+#include "Async/ParallelFor.h"
+#include "Algo/Reverse.h"
+
+namespace
+{
+	constexpr int32 Unreached = MAX_int32;
+
+	struct FOpenEntry
+	{
+		int32 F;
+		int32 H;
+		int32 Index;
+	};
+
+	struct FOpenLess
+	{
+		FORCEINLINE bool operator()(const FOpenEntry& A, const FOpenEntry& B) const
+		{
+			return A.F < B.F || (A.F == B.F && A.H < B.H);
+		}
+	};
+
+	/** Coût restant jusqu'à Goal depuis chaque case (Dijkstra inverse) : heuristique exacte sans obstacles mobiles */
+	void BuildTrueDistance(const FHexGridSnapshot& Snap, int32 Goal, TArray<int32>& Out)
+	{
+		Out.Init(Unreached, Snap.Num());
+		TArray<FOpenEntry> Heap;
+		Out[Goal] = 0;
+		Heap.HeapPush(FOpenEntry{0, 0, Goal}, FOpenLess());
+		Snap.WithTileIndexer([&](const auto& Indexer)
+		{
+			while (Heap.Num() > 0)
+			{
+				FOpenEntry Top;
+				Heap.HeapPop(Top, FOpenLess(), EAllowShrinking::No);
+				if (Top.F != Out[Top.Index])
+					continue;
+
+				// V -> Cur coûte l'entrée dans Cur
+				const int32 Enter = Snap.MoveCosts[Top.Index];
+				if (Enter == 0)
+					continue;
+				Snap.ForEachNeighborIndex(Indexer, Top.Index, [&](int32 NIdx, int32 /*Dir*/)
+				{
+					const int32 D = Top.F + Enter;
+					if (Snap.MoveCosts[NIdx] == 0 || D >= Out[NIdx])
+						return;
+					Out[NIdx] = D;
+					Heap.HeapPush(FOpenEntry{D, 0, NIdx}, FOpenLess());
+				});
+			}
+		});
+	}
+
+	/** Réservations du lot : cases occupées à un pas, mouvements (pour les échanges), cases où un agent s'est arrêté */
+	struct FReservationTable
+	{
+		TSet<uint64> Vertices;
+		TSet<uint64> Edges;
+		TMap<int32, int32> Parked;  // case -> pas à partir duquel elle est occupée pour de bon
+		TMap<int32, int32> Waiting; // départ d'un agent pas encore planifié -> nombre d'agents (occupé à tout pas)
+		uint64 NumTiles = 0;
+
+		static uint64 VertexKey(int32 Tile, int32 Step) { return (uint64(uint32(Step)) << 32) | uint32(Tile); }
+		uint64 EdgeKey(int32 From, int32 To, int32 Step) const { return (uint64(uint32(Step)) << 48) | (uint64(uint32(From)) * NumTiles + uint32(To)); }
+
+		bool IsOccupied(int32 Tile, int32 Step) const
+		{
+			const int32* Since = Parked.Find(Tile);
+			return (Since && Step >= *Since) || Waiting.Contains(Tile) || Vertices.Contains(VertexKey(Tile, Step));
+		}
+
+		/** Un autre agent fait To -> From pendant le même pas : échange interdit */
+		bool IsSwap(int32 From, int32 To, int32 Step) const { return Edges.Contains(EdgeKey(To, From, Step)); }
+
+		/** Rester sur Tile de Step jusqu'à la fin de l'horizon */
+		bool CanPark(int32 Tile, int32 Step, int32 Window) const
+		{
+			if (Parked.Contains(Tile) || Waiting.Contains(Tile))
+				return false;
+			for (int32 S = Step; S <= Window; ++S)
+				if (Vertices.Contains(VertexKey(Tile, S)))
+					return false;
+			return true;
+		}
+
+		/** Départ d'un agent pas encore planifié : personne n'y passe tant que son plan ne dit pas quand il part */
+		void AddWaiting(int32 Tile) { ++Waiting.FindOrAdd(Tile); }
+
+		/** Retire le départ de l'agent qu'on planifie ; false si un autre agent attend sur la même case */
+		bool RemoveWaiting(int32 Tile)
+		{
+			int32* Count = Waiting.Find(Tile);
+			if (Count && --*Count == 0)
+			{
+				Waiting.Remove(Tile);
+				return true;
+			}
+			return Count == nullptr;
+		}
+
+		void Reserve(TConstArrayView<int32> Tiles)
+		{
+			for (int32 Step = 0; Step < Tiles.Num(); ++Step)
+			{
+				Vertices.Add(VertexKey(Tiles[Step], Step));
+				if (Step > 0 && Tiles[Step] != Tiles[Step - 1])
+					Edges.Add(EdgeKey(Tiles[Step - 1], Tiles[Step], Step - 1));
+			}
+			Parked.Add(Tiles.Last(), Tiles.Num() - 1);
+		}
+	};
+
+	/** Noeud espace-temps (case, pas) ; seuls les états visités existent (cf. FStateSet) */
+	struct FStateNode
+	{
+		int32 Tile;
+		int32 Step;
+		int32 G;
+		int32 Spent;  // points de mouvement dépensés (les attentes sont gratuites)
+		int32 Parent; // index dans FStateSet::Nodes
+		bool  bClosed;
+	};
+
+	/**
+	 * États visités par la recherche d'un agent : tableau compact + table (case, pas) -> index.
+	 * Mémoire proportionnelle aux états développés, pas à Window * nombre de cases.
+	 */
+	struct FStateSet
+	{
+		TArray<FStateNode> Nodes;
+		TMap<uint64, int32> IndexOf;
+
+		void Reset()
+		{
+			Nodes.Reset();
+			IndexOf.Reset();
+		}
+
+		/** Index de l'état (case, pas), créé non fermé avec G = Unreached s'il n'existe pas */
+		int32 FindOrAdd(int32 Tile, int32 Step)
+		{
+			int32& Index = IndexOf.FindOrAdd(FReservationTable::VertexKey(Tile, Step), INDEX_NONE);
+			if (Index == INDEX_NONE)
+				Index = Nodes.Add(FStateNode{Tile, Step, Unreached, 0, INDEX_NONE, false});
+			return Index;
+		}
+	};
+}
+
+void FHexCooperativePlanner::Plan(const FHexGridSnapshot& Snap, TConstArrayView<FHexAgentMoveRequest> Agents, int32 Window, int32 Budget,
+                                  const std::atomic<bool>& Cancelled, FHexCooperativePlan& Out)
+{
+	const int32 NumAgents = Agents.Num();
+	const int32 NumTiles = Snap.Num();
+	Window = FMath::Clamp(Window, 1, MaxWindow);
+	Out.Window = Window;
+	Out.Paths.SetNum(NumAgents);
+	Out.bReachedGoal.Init(false, NumAgents);
+	Out.bFailed.Init(false, NumAgents);
+
+	// 1) Heuristiques exactes : indépendantes entre agents, donc en parallèle
+	TArray<int32> StartIdx, GoalIdx;
+	StartIdx.SetNumUninitialized(NumAgents);
+	GoalIdx.SetNumUninitialized(NumAgents);
+	for (int32 a = 0; a < NumAgents; ++a)
+	{
+		StartIdx[a] = Snap.GetTileIndex(Agents[a].Start);
+		GoalIdx[a] = Snap.GetTileIndex(Agents[a].Goal);
+	}
+
+	TArray<TArray<int32>> TrueDistance;
+	TrueDistance.SetNum(NumAgents);
+	ParallelFor(NumAgents, [&](int32 a)
+	{
+		if (Snap.HasTileAtIndex(GoalIdx[a]) && !Cancelled.load(std::memory_order_relaxed))
+			BuildTrueDistance(Snap, GoalIdx[a], TrueDistance[a]);
+	});
+
+	// 2) A* espace-temps, agent par agent, contre les réservations des précédents.
+	//    Les départs des agents suivants sont bloqués d'emblée : un prioritaire ne peut ni les traverser
+	//    ni s'y arrêter, donc chaque agent peut toujours au moins rester sur place.
+	FReservationTable Reservations;
+	Reservations.NumTiles = uint64(NumTiles);
+	for (int32 a = 0; a < NumAgents; ++a)
+		if (Snap.HasTileAtIndex(StartIdx[a]))
+			Reservations.AddWaiting(StartIdx[a]);
+
+	FStateSet States;
+	TArray<FOpenEntry> Heap;
+	TArray<int32> Tiles;
+
+	Snap.WithTileIndexer([&](const auto& Indexer)
+	{
+		for (int32 a = 0; a < NumAgents; ++a)
+		{
+			if (Cancelled.load(std::memory_order_relaxed))
+				return;
+
+			const int32 Start = StartIdx[a];
+			const int32 Goal = GoalIdx[a];
+			if (!Snap.HasTileAtIndex(Start))
+			{
+				Out.bFailed[a] = true; // agent hors grille : pas de chemin, rien à réserver
+				continue;
+			}
+			if (!Reservations.RemoveWaiting(Start))
+			{
+				Out.bFailed[a] = true; // même départ qu'un autre agent : aucun plan sûr
+				continue;
+			}
+
+			Tiles.Reset();
+			const TArray<int32>& Dist = TrueDistance[a];
+			if (Dist.Num() == 0 || Dist[Start] == Unreached)
+			{
+				// But absent ou inatteignable : l'agent reste sur place (case réservée pour lui seul)
+				Tiles.Add(Start);
+			}
+			else
+			{
+				States.Reset();
+				Heap.Reset();
+				const int32 Root = States.FindOrAdd(Start, 0);
+				States.Nodes[Root].G = 0;
+				Heap.HeapPush(FOpenEntry{Dist[Start], Dist[Start], Root}, FOpenLess());
+
+				int32 Best = INDEX_NONE;
+				int32 BestH = Unreached;
+				int32 BestG = Unreached;
+				while (Heap.Num() > 0)
+				{
+					FOpenEntry Top;
+					Heap.HeapPop(Top, FOpenLess(), EAllowShrinking::No);
+					if (States.Nodes[Top.Index].bClosed)
+						continue;
+					States.Nodes[Top.Index].bClosed = true;
+					++Out.NodesExpanded;
+
+					// Copie : FindOrAdd peut réallouer Nodes pendant le relâchement
+					const FStateNode Cur = States.Nodes[Top.Index];
+					const int32 Tile = Cur.Tile;
+					const int32 Step = Cur.Step;
+
+					// Meilleure case où l'agent peut s'arrêter ; le but sûr termine la recherche
+					if (Reservations.CanPark(Tile, Step, Window))
+					{
+						if (Tile == Goal)
+						{
+							Best = Top.Index;
+							break;
+						}
+						if (Dist[Tile] < BestH || (Dist[Tile] == BestH && Cur.G < BestG))
+						{
+							Best = Top.Index;
+							BestH = Dist[Tile];
+							BestG = Cur.G;
+						}
+					}
+					if (Step == Window)
+						continue;
+
+					const int32 CurIdx = Top.Index;
+					auto Relax = [&](int32 Next)
+					{
+						const bool bWait = Next == Tile;
+						const int32 MoveCost = bWait ? 0 : Snap.MoveCosts[Next];
+						if (!bWait && (MoveCost == 0 || Dist[Next] == Unreached))
+							return;
+						if (Budget > 0 && Cur.Spent + MoveCost > Budget)
+							return;
+						if (Reservations.IsOccupied(Next, Step + 1) || (!bWait && Reservations.IsSwap(Tile, Next, Step)))
+							return;
+
+						// Attendre coûte 1 (sinon les attentes seraient gratuites à l'infini)
+						const int32 TentativeG = Cur.G + (bWait ? 1 : MoveCost);
+						const int32 NIdx = States.FindOrAdd(Next, Step + 1);
+						FStateNode& N = States.Nodes[NIdx];
+						if (N.bClosed || TentativeG >= N.G)
+							return;
+						N.G = TentativeG;
+						N.Spent = Cur.Spent + MoveCost;
+						N.Parent = CurIdx;
+						Heap.HeapPush(FOpenEntry{TentativeG + Dist[Next], Dist[Next], NIdx}, FOpenLess());
+					};
+
+					Relax(Tile);
+					Snap.ForEachNeighborIndex(Indexer, Tile, [&](int32 NIdx, int32 /*Dir*/) { Relax(NIdx); });
+				}
+
+				if (Best == INDEX_NONE)
+				{
+					// Aucune case sûre dans l'horizon : on ne renvoie rien plutôt qu'un arrêt en conflit.
+					// L'agent reste physiquement sur son départ : la case reste bloquée pour les suivants.
+					Out.bFailed[a] = true;
+					Reservations.Parked.Add(Start, 0);
+					continue;
+				}
+
+				for (int32 S = Best; S != INDEX_NONE; S = States.Nodes[S].Parent)
+					Tiles.Add(States.Nodes[S].Tile);
+				Algo::Reverse(Tiles);
+				Out.bReachedGoal[a] = Tiles.Last() == Goal;
+			}
+
+			Reservations.Reserve(Tiles);
+			TArray<FHexAxialCoordinates>& Path = Out.Paths[a];
+			Path.SetNumUninitialized(Tiles.Num());
+			for (int32 i = 0; i < Tiles.Num(); ++i)
+				Path[i] = Snap.TileCoords[Tiles[i]];
+		}
+	});
+}
@@ -0,0 +1,226 @@
+#include "HexDStarLite.h"
+#include "HexGridManager.h"
+#include "Demo.h"
+
+namespace
+{
+	// Tas min sur la clé (K1, K2)
+	struct FKeyLess
+	{
+		template <typename T>
+		FORCEINLINE bool operator()(const T& A, const T& B) const
+		{
+			return A.Key < B.Key;
+		}
+	};
+}
+
+template <typename FuncType>
+void FHexDStarLite::ForEachNeighbor(const UHexGridManager& Grid, int32 Index, FuncType&& Fn) const
+{
+	const FHexAxialCoordinates C = Grid.GetTileCoords(Index);
+	for (int32 Dir = 0; Dir < 6; ++Dir)
+	{
+		const int32 N = UHexGridManager::ComputeTileIndex(
+			FHexAxialCoordinates{C.Q + HexMath::NeighborDQ[Dir], C.R + HexMath::NeighborDR[Dir]}, Radius, bOffsetOnQ);
+		if (N != INDEX_NONE)
+			Fn(N);
+	}
+}
+
+int32 FHexDStarLite::H(const UHexGridManager& Grid, int32 A, int32 B) const
+{
+	return Grid.AxialDistance(Grid.GetTileCoords(A), Grid.GetTileCoords(B));
+}
+
+FHexDStarLite::FKey FHexDStarLite::CalculateKey(const UHexGridManager& Grid, int32 Index) const
+{
+	const int32 M = FMath::Min(G[Index], Rhs[Index]);
+	return FKey{M >= Infinity ? Infinity : M + H(Grid, StartIndex, Index) + KM, M};
+}
+
+void FHexDStarLite::UpdateVertex(const UHexGridManager& Grid, int32 Index)
+{
+	if (Index != GoalIndex)
+	{
+		// rhs = meilleur voisin : entrer dans N coûte KnownCosts[N]
+		int32 Best = Infinity;
+		ForEachNeighbor(Grid, Index, [&](int32 N)
+		{
+			if (KnownCosts[N] > 0 && G[N] < Infinity)
+				Best = FMath::Min(Best, G[N] + KnownCosts[N]);
+		});
+		Rhs[Index] = Best;
+	}
+
+	if (G[Index] != Rhs[Index])
+	{
+		const FKey Key = CalculateKey(Grid, Index);
+		if (!InOpen[Index] || !(OpenKeys[Index] == Key))
+		{
+			InOpen[Index] = true;
+			OpenKeys[Index] = Key;
+			Heap.HeapPush(FOpenEntry{Key, Index}, FKeyLess());
+		}
+	}
+	else
+	{
+		InOpen[Index] = false; // l'entrée restée dans le tas sera ignorée
+	}
+}
+
+bool FHexDStarLite::ComputeShortestPath(const UHexGridManager& Grid)
+{
+	LastExpanded = 0;
+	const int32 MaxExpansions = 8 * G.Num() + 64; // garde-fou : chaque sommet ne bouge qu'un nombre borné de fois
+
+	while (Heap.Num() > 0)
+	{
+		if (LastExpanded >= MaxExpansions)
+		{
+			// g incohérent : on oublie tout, l'appelant repart d'une recherche complète
+			UE_LOG(LogHexPath, Warning, TEXT("[DStarLite] Gave up after %d expansions"), LastExpanded);
+			GoalIndex = INDEX_NONE;
+			return false;
+		}
+
+		const FOpenEntry& Top = Heap.HeapTop();
+		if (!InOpen[Top.Index] || !(OpenKeys[Top.Index] == Top.Key))
+		{
+			Heap.HeapPopDiscard(FKeyLess(), EAllowShrinking::No);
+			continue;
+		}
+
+		const FKey StartKey = CalculateKey(Grid, StartIndex);
+		if (!(Top.Key < StartKey) && Rhs[StartIndex] == G[StartIndex])
+			break;
+
+		const int32 U = Top.Index;
+		const FKey OldKey = Top.Key;
+		Heap.HeapPopDiscard(FKeyLess(), EAllowShrinking::No);
+		++LastExpanded;
+
+		const FKey NewKey = CalculateKey(Grid, U);
+		if (OldKey < NewKey)
+		{
+			OpenKeys[U] = NewKey;
+			Heap.HeapPush(FOpenEntry{NewKey, U}, FKeyLess());
+		}
+		else if (G[U] > Rhs[U])
+		{
+			G[U] = Rhs[U];
+			InOpen[U] = false;
+			ForEachNeighbor(Grid, U, [&](int32 P) { UpdateVertex(Grid, P); });
+		}
+		else
+		{
+			G[U] = Infinity;
+			UpdateVertex(Grid, U);
+			ForEachNeighbor(Grid, U, [&](int32 P) { UpdateVertex(Grid, P); });
+		}
+	}
+	return true;
+}
+
+bool FHexDStarLite::Initialize(const UHexGridManager& Grid, const FHexAxialCoordinates& Start, const FHexAxialCoordinates& Goal)
+{
+	StartIndex = GoalIndex = INDEX_NONE;
+	const int32 S = Grid.GetTileIndex(Start);
+	const int32 T = Grid.GetTileIndex(Goal);
+	if (!Grid.HasTileAtIndex(S) || !Grid.HasTileAtIndex(T))
+		return false;
+
+	const int32 Count = Grid.GetTileIndexCount();
+	Radius = Grid.GetIndexedRadius();
+	bOffsetOnQ = Grid.bOffsetOnQ;
+	StartIndex = S;
+	GoalIndex = T;
+	GoalCoords = Goal;
+	KM = 0;
+
+	G.Init(Infinity, Count);
+	Rhs.Init(Infinity, Count);
+	OpenKeys.SetNumUninitialized(Count);
+	InOpen.Init(false, Count);
+	Heap.Reset();
+
+	KnownCosts.SetNumUninitialized(Count);
+	for (int32 i = 0; i < Count; ++i)
+		KnownCosts[i] = Grid.HasTileAtIndex(i) ? Grid.GetTileMoveCostAtIndex(i) : 0;
+
+	Rhs[GoalIndex] = 0;
+	InOpen[GoalIndex] = true;
+	OpenKeys[GoalIndex] = CalculateKey(Grid, GoalIndex);
+	Heap.HeapPush(FOpenEntry{OpenKeys[GoalIndex], GoalIndex}, FKeyLess());
+
+	return ComputeShortestPath(Grid);
+}
+
+bool FHexDStarLite::MoveStart(const UHexGridManager& Grid, const FHexAxialCoordinates& NewStart)
+{
+	const int32 S = UHexGridManager::ComputeTileIndex(NewStart, Radius, bOffsetOnQ);
+	if (!IsInitialized() || S == INDEX_NONE || Grid.GetTileIndexCount() != G.Num())
+		return false;
+
+	// Les clés déjà en file restent des bornes inférieures valides grâce à km
+	KM += H(Grid, StartIndex, S);
+	StartIndex = S;
+	return true;
+}
+
+bool FHexDStarLite::SyncWithGrid(const UHexGridManager& Grid)
+{
+	const int32 Count = Grid.GetTileIndexCount();
+	if (!IsInitialized() || Count != G.Num() || Grid.GetIndexedRadius() != Radius)
+		return false;
+
+	// Un changement de coût d'entrée de C modifie les arcs V -> C : ce sont les voisins qu'on remet à jour
+	bool bChanged = false;
+	for (int32 i = 0; i < Count; ++i)
+	{
+		const uint8 Cost = Grid.HasTileAtIndex(i) ? Grid.GetTileMoveCostAtIndex(i) : 0;
+		if (Cost == KnownCosts[i])
+			continue;
+		KnownCosts[i] = Cost;
+		bChanged = true;
+		ForEachNeighbor(Grid, i, [&](int32 P) { UpdateVertex(Grid, P); });
+	}
+
+	if (bChanged || InOpen[StartIndex] || G[StartIndex] != Rhs[StartIndex])
+		return ComputeShortestPath(Grid);
+	return true;
+}
+
+bool FHexDStarLite::ExtractPath(const UHexGridManager& Grid, int32 Budget, TArray<FHexAxialCoordinates>& OutPath) const
+{
+	OutPath.Reset();
+	if (!IsInitialized() || (G[StartIndex] >= Infinity && StartIndex != GoalIndex))
+		return false;
+
+	// Descente gloutonne sur g : chaque pas prend le voisin qui minimise coût d'entrée + g
+	int32 Cur = StartIndex;
+	int32 Spent = 0;
+	OutPath.Add(Grid.GetTileCoords(Cur));
+	for (int32 Guard = 0; Cur != GoalIndex && Guard < G.Num(); ++Guard)
+	{
+		int32 Next = INDEX_NONE;
+		int32 Best = Infinity;
+		ForEachNeighbor(Grid, Cur, [&](int32 N)
+		{
+			if (KnownCosts[N] > 0 && G[N] < Infinity && G[N] + KnownCosts[N] < Best)
+			{
+				Best = G[N] + KnownCosts[N];
+				Next = N;
+			}
+		});
+		if (Next == INDEX_NONE)
+			return false;
+
+		Spent += KnownCosts[Next];
+		if (Budget > 0 && Spent > Budget)
+			break;
+		OutPath.Add(Grid.GetTileCoords(Next));
+		Cur = Next;
+	}
+	return true;
+}
@@ -1,153 +1,895 @@
 // HexGridManager.cpp
 
 #include "HexGridManager.h"
+#include "Demo.h"
+#include "HexGridSnapshot.h"
+#include "HexStats.h"
 #include "Engine/World.h"
 #include "EngineUtils.h"
 #include "DrawDebugHelpers.h"
 #include "HexTile.h"
 #include "Kismet/GameplayStatics.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Async/ParallelFor.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 
-// Deltas voisins en doubled-q: W, NW, NE, E, SE, SW
-static const FHexAxialCoordinates GDQ6[6] = {
-    {-2, 0}, {-2, +1}, {0, +1}, {+2, 0}, {+2, -1}, {0, -1}};
+namespace
+{
+    // Cache de grille : en-tête + une entrée par tuile présente
+    constexpr uint32 HexGridCacheMagic = 0x43475848; // 'HXGC'
+    constexpr uint32 HexGridCacheVersion = 1;        // à incrémenter si le format ou la génération change
+}
 
+/** Voisins attendus / masque réel autour de C ; LogHexGrid VeryVerbose uniquement ("log LogHexGrid VeryVerbose") */
 static void DumpNeighborsOf(const UHexGridManager *Grid, const FHexAxialCoordinates &C, const TCHAR *Label)
 {
-    UE_LOG(LogTemp, Warning, TEXT("[Dbg] %s center=(%d,%d)"), Label, C.Q, C.R);
+    if (!UE_LOG_ACTIVE(LogHexGrid, VeryVerbose))
+        return;
+
+    UE_LOG(LogHexGrid, VeryVerbose, TEXT("[Dbg] %s center=(%d,%d)"), Label, C.Q, C.R);
 
     // Candidats attendus
     for (int i = 0; i < 6; ++i)
     {
-        const FHexAxialCoordinates N{C.Q + GDQ6[i].Q, C.R + GDQ6[i].R};
-        const bool bPresent = (Grid && Grid->GetHexTileAt(N) != nullptr);
-        UE_LOG(LogTemp, Warning, TEXT("[Dbg]  cand %d -> (%d,%d) present=%d"), i, N.Q, N.R, bPresent ? 1 : 0);
+        const FHexAxialCoordinates N{C.Q + HexMath::NeighborDQ[i], C.R + HexMath::NeighborDR[i]};
+        const bool bPresent = (Grid && Grid->HasTileAt(N));
+        UE_LOG(LogHexGrid, VeryVerbose, TEXT("[Dbg]  cand %d -> (%d,%d) present=%d"), i, N.Q, N.R, bPresent ? 1 : 0);
     }
 
-    // Ce que renvoie réellement GetNeighbors
+    // Ce que renvoie réellement le masque de voisins
     if (Grid)
     {
-        TArray<FHexAxialCoordinates> Out = Grid->GetNeighbors(C);
-        FString S = FString::JoinBy(Out, TEXT(" "),
-                                    [](const FHexAxialCoordinates &X)
-                                    { return FString::Printf(TEXT("(%d,%d)"), X.Q, X.R); });
-        UE_LOG(LogTemp, Warning, TEXT("[Dbg]  GetNeighbors -> %s"), *S);
+        FString S;
+        Grid->ForEachNeighbor(C, [&S](const FHexAxialCoordinates &X)
+                              { S += FString::Printf(TEXT("(%d,%d) "), X.Q, X.R); });
+        UE_LOG(LogHexGrid, VeryVerbose, TEXT("[Dbg]  GetNeighbors -> %s"), *S);
     }
 }
 
 UHexGridManager::UHexGridManager()
 {
-    PrimaryComponentTick.bCanEverTick = false;
+    // Tick seulement pour grouper les mises à jour de custom data (mode Instanced)
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
 }
 
 void UHexGridManager::InitializeGrid(int32 Radius, TSubclassOf<AHexTile> TileClass)
 {
     GridRadius = Radius;
     HexTileClass = TileClass;
+
+    // Terrain inchangé depuis la dernière génération : ni trace ni tirage
+    if (bUseBakedGridCache && LoadBakedGrid())
+        return;
     RebuildGrid();
 }
 
 void UHexGridManager::RebuildGrid()
 {
+    HEX_SCOPE(STAT_HexGridRebuild, "Hex::RebuildGrid");
+
+    // 0) Abandonne une génération asynchrone en cours
+    CancelGeneration();
+
     // 1) Détruire l'existant
-    for (auto &Kvp : TilesMap)
+    for (AHexTile *T : TileActors)
     {
-        if (AHexTile *T = Kvp.Value.Get())
-        {
-            if (IsValid(T) && !T->IsActorBeingDestroyed())
-                T->Destroy();
-        }
+        if (IsValid(T) && !T->IsActorBeingDestroyed())
+            T->Destroy();
     }
-    TilesMap.Empty();
+    ResetTileStorage(INDEX_NONE);
 
     // 2) Vérifs
     UWorld *World = GetWorld();
-    if (!World || !*HexTileClass)
+    const bool bInstanced = IsInstanced();
+    if (!World || (bInstanced ? !InstancedTileMesh : !*HexTileClass))
     {
-        UE_LOG(LogTemp, Error, TEXT("RebuildGrid: World or HexTileClass invalid"));
+        UE_LOG(LogHexGrid, Error, TEXT("RebuildGrid: World or HexTileClass/InstancedTileMesh invalid"));
+        NotifyGridChanged(INDEX_NONE);
         return;
     }
 
+    // Les SetTileType du rebuild ne notifient pas individuellement
+    bRebuildingGrid = true;
+
     // 3) Origine par défaut
-    if (GridOrigin.IsNearlyZero() && GetOwner())
-        GridOrigin = GetOwner()->GetActorLocation();
+    GridOrigin = GetEffectiveGridOrigin();
 
-    UE_LOG(LogTemp, Warning, TEXT("Rebuilding hex grid (Radius=%d, TileSize=%.1f)"), GridRadius, TileSize);
+    UE_LOG(LogHexGrid, Log, TEXT("Rebuilding hex grid (Radius=%d, TileSize=%.1f)"), GridRadius, TileSize);
 
-    // 4) Boucle de génération telle que tu l’utilises déjà (indices affichage Col/Row = Q/R)
+    ResetTileStorage(GridRadius);
+
+    // 4) Une entrée par case de l'hexagone (indices affichage Col/Row = Q/R), Z résolu par trace
+    GroundCells.Reset(TileCoords.Num());
     for (int32 q = -GridRadius; q <= GridRadius; ++q)
     {
         const int32 rMin = FMath::Max(-GridRadius, -q - GridRadius);
         const int32 rMax = FMath::Min(GridRadius, -q + GridRadius);
 
         for (int32 r = rMin; r <= rMax; ++r)
+            GroundCells.Add(FGroundTraceCell{q, r, 0.f, false, false});
+    }
+
+    GenerationStartSeconds = FPlatformTime::Seconds();
+    GroundTracesDone = 0;
+    GroundTracesTotal = GroundCells.Num();
+    bGenerating = true;
+
+    // 5a) Asynchrone : tous les traces partent en lot, résultats au(x) frame(s) suivant(s)
+    if (bAsyncGroundTraces && World->IsGameWorld())
+    {
+        SetComponentTickEnabled(true); // diffusion de la progression
+        IssueGroundTraces(/*bObjectPass*/ false);
+        return;
+    }
+
+    // 5b) Synchrone (éditeur / CallInEditor)
+    for (FGroundTraceCell &Cell : GroundCells)
+    {
+        FVector SpawnLocation;
+        Cell.bAccepted = TryComputeTileSpawnPosition(Cell.Col, Cell.Row, SpawnLocation);
+        Cell.Z = SpawnLocation.Z;
+    }
+    GroundTracesDone = GroundTracesTotal;
+    FinishRebuildGrid(/*bFromBake*/ false);
+}
+
+void UHexGridManager::IssueGroundTraces(bool bObjectPass)
+{
+    UWorld *World = GetWorld();
+    check(World);
+
+    FCollisionQueryParams Params(SCENE_QUERY_STAT(HexGroundTrace), bTraceComplex);
+    if (const AActor *Owner = GetOwner())
+        Params.AddIgnoredActor(Owner);
+
+    FCollisionObjectQueryParams Obj;
+    Obj.AddObjectTypesToQuery(ECC_WorldStatic);
+    Obj.AddObjectTypesToQuery(ECC_WorldDynamic);
+
+    // Le numéro de génération rend muets les résultats d'un rebuild abandonné
+    const FTraceDelegate Delegate = FTraceDelegate::CreateUObject(this, &UHexGridManager::OnGroundTraceDone, GenerationSerial, bObjectPass);
+
+    GroundTracesInFlight = 0;
+    for (int32 i = 0; i < GroundCells.Num(); ++i)
+    {
+        const FGroundTraceCell &Cell = GroundCells[i];
+        if (bObjectPass && Cell.bHit)
+            continue;
+
+        const FVector2D XY = ComputeTileXY(Cell.Col, Cell.Row);
+        const FVector Base(XY.X, XY.Y, GridOrigin.Z);
+        const FVector Start = Base + FVector(0, 0, TraceHeight);
+        const FVector End = Base - FVector(0, 0, TraceDepth);
+
+        if (bObjectPass)
+            World->AsyncLineTraceByObjectType(EAsyncTraceType::Single, Start, End, Obj, Params, &Delegate, uint32(i));
+        else
+            World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, End, ECC_Visibility, Params,
+                                           FCollisionResponseParams::DefaultResponseParam, &Delegate, uint32(i));
+        ++GroundTracesInFlight;
+    }
+
+    if (bObjectPass)
+        GroundTracesTotal += GroundTracesInFlight;
+
+    if (GroundTracesInFlight == 0)
+        FinishRebuildGrid(/*bFromBake*/ false);
+}
+
+void UHexGridManager::OnGroundTraceDone(const FTraceHandle &Handle, FTraceDatum &Datum, uint32 Serial, bool bObjectPass)
+{
+    if (Serial != GenerationSerial || !bGenerating || !GroundCells.IsValidIndex(int32(Datum.UserData)))
+        return;
+
+    FGroundTraceCell &Cell = GroundCells[Datum.UserData];
+    const FHitResult *Hit = Datum.OutHits.FindByPredicate([](const FHitResult &H) { return H.bBlockingHit; });
+    if (Hit)
+    {
+        // Un hit (même refusé par le filtre Floor) ne déclenche pas de second passage, comme en synchrone
+        Cell.bHit = true;
+        Cell.bAccepted = AcceptGroundHit(Cell.Col, Cell.Row, *Hit, Cell.Z);
+    }
+
+    ++GroundTracesDone;
+    if (--GroundTracesInFlight > 0)
+        return;
+
+    // Passage 2 (objets WorldStatic/WorldDynamic) uniquement pour les cases sans hit
+    if (!bObjectPass)
+        IssueGroundTraces(/*bObjectPass*/ true);
+    else
+        FinishRebuildGrid(/*bFromBake*/ false);
+}
+
+void UHexGridManager::FinishRebuildGrid(bool bFromBake)
+{
+    HEX_SCOPE(STAT_HexGridSpawn, "Hex::FinishRebuildGrid");
+    UWorld *World = GetWorld();
+    const bool bInstanced = IsInstanced();
+
+    // Mode Instanced : transforms collectés puis ajoutés en un seul lot
+    int32 Spawned = 0;
+    TArray<FTransform> InstanceTransforms;
+    TArray<int32> InstanceTiles;
+    if (bInstanced)
+    {
+        InstanceTransforms.Reserve(GroundCells.Num());
+        InstanceTiles.Reserve(GroundCells.Num());
+    }
+
+    for (const FGroundTraceCell &Cell : GroundCells)
+    {
+        // Pas de sol, ou sol refusé (Floor)
+        if (!Cell.bAccepted)
+            continue;
+
+        const int32 q = Cell.Col;
+        const int32 r = Cell.Row;
+        const FVector2D XY = ComputeTileXY(q, r);
+        const FVector SpawnLocation(XY.X, XY.Y, Cell.Z);
+
+        if (bInstanced)
         {
-            FVector SpawnLocation;
-            if (!TryComputeTileSpawnPosition(q, r, SpawnLocation))
-                continue;
+            const int32 Index = GetTileIndex(MapSpawnIndexToAxial(q, r));
+            check(Index != INDEX_NONE);
+            if (!bFromBake && bRandomizeEnemyOnBuild && FMath::FRand() < EnemyChance)
+                TileTypes[Index] = EHexTileType::Enemy;
+            TileHeights[Index] = SpawnLocation.Z;
+            TilePresent[Index] = true;
+            TileVisible[Index] = true;
 
-            FActorSpawnParameters P;
-            P.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+            InstanceTransforms.Emplace(FQuat::Identity, SpawnLocation, InstancedTileScale);
+            InstanceTiles.Add(Index);
+            continue;
+        }
+
+        FActorSpawnParameters P;
+        P.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
 
-            AHexTile *Tile = World->SpawnActor<AHexTile>(HexTileClass, SpawnLocation, FRotator::ZeroRotator, P);
-            if (!Tile)
-                continue;
+        AHexTile *Tile = World->SpawnActor<AHexTile>(HexTileClass, SpawnLocation, FRotator::ZeroRotator, P);
+        if (!Tile)
+            continue;
+        ++Spawned;
 
-            const FHexAxialCoordinates Axial = MapSpawnIndexToAxial(q, r); // <- mapping corrigé
-            Tile->SetAxialCoordinates(Axial);
-            if (bRandomizeEnemyOnBuild && Tile && Tile->GetTileType() == EHexTileType::Normal)
+        const FHexAxialCoordinates Axial = MapSpawnIndexToAxial(q, r); // <- mapping corrigé
+        Tile->SetAxialCoordinates(Axial);
+        if (bFromBake)
+            Tile->SetTileType(TileTypes[GetTileIndex(Axial)]); // tirages et cases spéciales déjà cuits
+        else if (bRandomizeEnemyOnBuild && Tile && Tile->GetTileType() == EHexTileType::Normal)
 {
     const float roll = FMath::FRand();     // was: const float r = EnemyRng.FRand();
     if (roll < EnemyChance)
         Tile->SetTileType(EHexTileType::Enemy);
 }
 #if WITH_EDITOR
-            Tile->SetActorLabel(FString::Printf(TEXT("Hex (%d,%d)"), Axial.Q, Axial.R));
+        Tile->SetActorLabel(FString::Printf(TEXT("Hex (%d,%d)"), Axial.Q, Axial.R));
 #endif
-            TilesMap.Add(Axial, TWeakObjectPtr<AHexTile>(Tile));
+        const int32 Index = GetTileIndex(Axial);
+        check(Index != INDEX_NONE);
+        TileActors[Index] = Tile;
+        TileTypes[Index] = Tile->GetTileType();
+        TileHeights[Index] = SpawnLocation.Z;
+        TilePresent[Index] = true;
+        TileVisible[Index] = true;
+    }
+    GroundCells.Empty();
+
+    if (bInstanced)
+    {
+        ResetTileInstances();
+        const TArray<int32> Ids = TileInstances->AddInstances(InstanceTransforms, /*bShouldReturnIndices*/ true, /*bWorldSpace*/ true);
+        Spawned = Ids.Num();
+
+        InstanceTileIndices.Init(INDEX_NONE, Ids.Num() ? FMath::Max(Ids) + 1 : 0);
+        for (int32 i = 0; i < Ids.Num(); ++i)
+        {
+            const int32 Index = InstanceTiles[i];
+            TileInstanceIds[Index] = Ids[i];
+            InstanceTileIndices[Ids[i]] = Index;
+
+            float Data[HexInstanceData::Num];
+            Data[HexInstanceData::Type] = float(TileTypes[Index]);
+            Data[HexInstanceData::Highlight] = 0.f;
+            Data[HexInstanceData::Elevation] = 0.f;
+            Data[HexInstanceData::Visible] = 1.f;
+            TileInstances->SetCustomData(Ids[i], MakeArrayView(Data, HexInstanceData::Num), /*bMarkRenderStateDirty*/ false);
         }
+        TileInstances->MarkRenderStateDirty();
     }
+    // Masques de voisins et types spéciaux : lus depuis le cache, sinon recalculés
+    if (!bFromBake)
+        RebuildNeighborMasks();
     DumpNeighborsOf(this, FHexAxialCoordinates{0, 0}, TEXT("AfterRebuild"));
-    DumpNeighborsOf(this, FHexAxialCoordinates{-8, -1}, TEXT("AfterRebuild"));
-    ApplySpecialTiles();
+    if (!bFromBake)
+        ApplySpecialTiles();
+
+    // Coûts dérivés des types (cuits ou non) : pas stockés dans le cache
+    RebuildMoveCosts();
 
     // Optionnel
     BuildWorldNeighbors();
+
+    bGenerating = false;
+    LastGenerationSeconds = FPlatformTime::Seconds() - GenerationStartSeconds;
+    const int32 TileCount = TilePresent.CountSetBits();
+    UE_LOG(LogHexGrid, Log, TEXT("[HexGrid] Generated %d tiles (%s, %d ground traces) in %.1f ms"),
+           TileCount, bFromBake ? TEXT("baked cache") : TEXT("traced"),
+           GroundTracesTotal, LastGenerationSeconds * 1000.0);
+    HexStats::RecordRebuild({TileCount, GroundTracesTotal, Spawned, bFromBake, LastGenerationSeconds});
+
+    if (!bFromBake && bUseBakedGridCache && World && World->IsGameWorld())
+        SaveBakedGrid();
+    OnGenerationProgress.Broadcast(1.f);
+
+    bRebuildingGrid = false;
+    NotifyGridChanged(INDEX_NONE);
+}
+
+FString UHexGridManager::GetBakedGridPath() const
+{
+    const UWorld *World = GetWorld();
+    const FString Level = World ? UWorld::RemovePIEPrefix(FPackageName::GetShortName(World->GetOutermost())) : TEXT("None");
+    return FPaths::ProjectSavedDir() / TEXT("HexGridCache") / (Level + TEXT(".hexgrid"));
+}
+
+FVector UHexGridManager::GetEffectiveGridOrigin() const
+{
+    // Origine nulle = « au pied du propriétaire »
+    if (GridOrigin.IsNearlyZero() && GetOwner())
+        return GetOwner()->GetActorLocation();
+    return GridOrigin;
+}
+
+uint32 UHexGridManager::ComputeBakeKey() const
+{
+    // Tout ce qui influe sur les tuiles produites : niveau, layout, traces, labels, cases spéciales
+    TArray<uint8> Bytes;
+    FMemoryWriter Ar(Bytes);
+
+    FString Level = GetWorld() ? UWorld::RemovePIEPrefix(GetWorld()->GetOutermost()->GetName()) : FString();
+    FString Floor = FloorTag.ToString();
+    FString TileClassPath = IsInstanced() ? FString() : GetPathNameSafe(HexTileClass.Get());
+    uint8 Mode = uint8(RenderMode);
+    Ar << Level << Floor << TileClassPath << Mode;
+
+    int32 Radius = GridRadius;
+    float Size = TileSize, XS = XSpacingFactor, YS = YSpacingFactor, ROF = RowOffsetFactor, ZOff = TileZOffset;
+    float TH = TraceHeight, TD = TraceDepth, Chance = EnemyChance;
+    // Origine effective : InitializeGrid charge avant que RebuildGrid n'ait résolu l'origine par défaut
+    FVector Origin = GetEffectiveGridOrigin();
+    FVector2D Nudge = GlobalXYNudge;
+    Ar << Radius << Size << XS << YS << ROF << ZOff << TH << TD << Chance << Origin << Nudge;
+
+    uint8 Flags[] = {bOffsetOnQ, bTraceComplex, bSkipTilesOverFloor, bRandomizeEnemyOnBuild};
+    Ar.Serialize(Flags, sizeof(Flags));
+
+    for (const TArray<FHexAxialCoordinates> *List : {&ShopTiles, &EnemyTiles})
+    {
+        int32 Num = List->Num();
+        Ar << Num;
+        for (FHexAxialCoordinates C : *List)
+            Ar << C.Q << C.R;
+    }
+
+    return FCrc::MemCrc32(Bytes.GetData(), Bytes.Num(), HexGridCacheVersion);
+}
+
+bool UHexGridManager::LoadBakedGrid()
+{
+    UWorld *World = GetWorld();
+    if (!World || !World->IsGameWorld() || (IsInstanced() ? !InstancedTileMesh : !*HexTileClass))
+        return false;
+
+    const double StartSeconds = FPlatformTime::Seconds();
+
+    // Une seule lecture, puis décodage en mémoire
+    TArray<uint8> Bytes;
+    const FString Path = GetBakedGridPath();
+    if (!FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent))
+        return false;
+
+    FMemoryReader Ar(Bytes);
+    uint32 Magic = 0, Version = 0, Key = 0;
+    int32 Radius = INDEX_NONE, Count = 0;
+    Ar << Magic << Version << Key << Radius << Count;
+    if (Ar.IsError() || Magic != HexGridCacheMagic || Version != HexGridCacheVersion ||
+        Key != ComputeBakeKey() || Radius != GridRadius || Count < 0)
+    {
+        UE_LOG(LogHexGrid, Log, TEXT("[HexGrid] Baked grid %s is stale, rebuilding"), *Path);
+        return false;
+    }
+
+    CancelGeneration();
+    for (AHexTile *T : TileActors)
+        if (IsValid(T) && !T->IsActorBeingDestroyed())
+            T->Destroy();
+    ResetTileStorage(Radius);
+
+    GridOrigin = GetEffectiveGridOrigin();
+
+    // Une entrée par tuile : un index vu deux fois ou un type inconnu signale un fichier abîmé
+    TBitArray<> Loaded(false, TileCoords.Num());
+    GroundCells.Reset(Count);
+    for (int32 i = 0; i < Count; ++i)
+    {
+        FHexAxialCoordinates C;
+        float Height = 0.f;
+        uint8 Type = 0, Mask = 0;
+        Ar << C.Q << C.R << Height << Type << Mask;
+
+        int32 Col = 0, Row = 0;
+        const int32 Index = GetTileIndex(C);
+        if (Ar.IsError() || Index == INDEX_NONE || Loaded[Index] || Type > uint8(EHexTileType::Goal) ||
+            !AxialToSpawnIndex(C, Col, Row))
+        {
+            UE_LOG(LogHexGrid, Warning, TEXT("[HexGrid] Baked grid %s is corrupt, rebuilding"), *Path);
+            ResetTileStorage(INDEX_NONE);
+            GroundCells.Reset();
+            return false;
+        }
+
+        Loaded[Index] = true;
+        TileTypes[Index] = EHexTileType(Type);
+        NeighborMasks[Index] = Mask;
+        GroundCells.Add(FGroundTraceCell{Col, Row, Height, true, true});
+    }
+
+    bRebuildingGrid = true;
+    bGenerating = true;
+    GenerationStartSeconds = StartSeconds;
+    GroundTracesDone = GroundTracesTotal = 0;
+    FinishRebuildGrid(/*bFromBake*/ true);
+    return true;
+}
+
+void UHexGridManager::SaveBakedGrid() const
+{
+    TArray<uint8> Bytes;
+    FMemoryWriter Ar(Bytes);
+
+    uint32 Magic = HexGridCacheMagic, Version = HexGridCacheVersion, Key = ComputeBakeKey();
+    int32 Radius = IndexedRadius;
+    int32 Count = TilePresent.CountSetBits();
+    Ar << Magic << Version << Key << Radius << Count;
+
+    for (TConstSetBitIterator<> It(TilePresent); It; ++It)
+    {
+        const int32 Index = It.GetIndex();
+        FHexAxialCoordinates C = TileCoords[Index];
+        float Height = TileHeights[Index];
+        uint8 Type = uint8(TileTypes[Index]);
+        uint8 Mask = NeighborMasks[Index];
+        Ar << C.Q << C.R << Height << Type << Mask;
+    }
+
+    const FString Path = GetBakedGridPath();
+    if (!FFileHelper::SaveArrayToFile(Bytes, *Path))
+        UE_LOG(LogHexGrid, Warning, TEXT("[HexGrid] Could not write baked grid %s"), *Path);
+}
+
+void UHexGridManager::ClearBakedGrid()
+{
+    IFileManager::Get().Delete(*GetBakedGridPath(), /*RequireExists*/ false, /*EvenReadOnly*/ true, /*Quiet*/ true);
+}
+
+#if !UE_BUILD_SHIPPING
+void UHexGridManager::BuildSyntheticGrid(int32 Radius, float HoleChance, float ObstacleChance, int32 Seed)
+{
+    HEX_SCOPE(STAT_HexGridRebuild, "Hex::BuildSyntheticGrid");
+    const double StartSeconds = FPlatformTime::Seconds();
+    CancelGeneration();
+    for (AHexTile *T : TileActors)
+        if (IsValid(T) && !T->IsActorBeingDestroyed())
+            T->Destroy();
+    // ResetTileStorage ne vide les instances que pour une grille vide : aucune ne doit survivre à la grille synthétique
+    if (TileInstances)
+        TileInstances->ClearInstances();
+    ResetTileStorage(FMath::Max(0, Radius));
+
+    // Tirages dans l'ordre des index : même Seed, même grille
+    FRandomStream Rng(Seed);
+    const int32 CenterIdx = GetTileIndex(FHexAxialCoordinates{0, 0});
+    for (int32 Index = 0; Index < TileCoords.Num(); ++Index)
+    {
+        const bool bHole = Rng.FRand() < HoleChance;
+        const bool bObstacle = Rng.FRand() < ObstacleChance;
+        const uint8 Cost = uint8(Rng.RandRange(1, 3));
+        if (bHole && Index != CenterIdx)
+            continue;
+
+        TilePresent[Index] = true;
+        TileVisible[Index] = true;
+        TileMoveCosts[Index] = (bObstacle && Index != CenterIdx) ? 0 : Cost;
+    }
+
+    RebuildNeighborMasks();
+    RecomputeMinMoveCost();
+    HexStats::RecordRebuild({TilePresent.CountSetBits(), 0, 0, false, FPlatformTime::Seconds() - StartSeconds});
+    NotifyGridChanged(INDEX_NONE);
+}
+#endif
+
+void UHexGridManager::CancelGeneration()
+{
+    // Les traces déjà lancés reviendront avec un ancien numéro et seront ignorés
+    ++GenerationSerial;
+    GroundTracesInFlight = 0;
+    GroundCells.Reset();
+    if (bGenerating)
+    {
+        bGenerating = false;
+        bRebuildingGrid = false;
+    }
+}
+
+float UHexGridManager::GetGenerationProgress() const
+{
+    if (!bGenerating)
+        return 1.f;
+    // Le second passage (objets) agrandit le total : la progression reste < 1 jusqu'au spawn
+    return GroundTracesTotal > 0 ? FMath::Min(0.99f, float(GroundTracesDone) / float(GroundTracesTotal)) : 0.f;
+}
+
+bool UHexGridManager::AcceptGroundHit(int32 Q, int32 R, const FHitResult &Hit, float &OutZ) const
+{
+    const AActor *HitA = Hit.GetActor();
+    if (bSkipTilesOverFloor)
+    {
+        if (!HitA)
+        {
+            UE_LOG(LogHexGrid, Verbose, TEXT("[HexGrid] (%d,%d): hit no actor -> skip"), Q, R);
+            return false;
+        }
+        if (HitA->ActorHasTag(FloorTag))
+        {
+            UE_LOG(LogHexGrid, Verbose, TEXT("[HexGrid] (%d,%d): Floor tag on %s -> skip"), Q, R, *HitA->GetName());
+            return false;
+        }
+    }
+
+    OutZ = Hit.Location.Z + TileZOffset;
+    return true;
+}
+
+TSharedRef<const FHexGridSnapshot, ESPMode::ThreadSafe> UHexGridManager::GetSnapshot() const
+{
+    if (CachedSnapshot.IsValid() && CachedSnapshot->Version == GridVersion && CachedSnapshot->Num() == TileCoords.Num())
+        return CachedSnapshot.ToSharedRef();
+
+    TSharedRef<FHexGridSnapshot, ESPMode::ThreadSafe> Snap = MakeShared<FHexGridSnapshot, ESPMode::ThreadSafe>();
+    Snap->Version = GridVersion;
+    Snap->Radius = IndexedRadius;
+    Snap->bOffsetOnQ = bOffsetOnQ;
+    Snap->TileCoords = TileCoords;
+    Snap->TileTypes = TileTypes;
+    Snap->NeighborMasks = NeighborMasks;
+    Snap->MoveCosts = TileMoveCosts;
+    Snap->MinMoveCost = MinMoveCost;
+    Snap->TilePresent = TilePresent;
+
+    CachedSnapshot = Snap;
+    return Snap;
+}
+
+void UHexGridManager::NotifyGridChanged(int32 TileIndex)
+{
+    if (bRebuildingGrid)
+        return;
+    ++GridVersion;
+    OnGridChanged.Broadcast(TileIndex);
 }
 
 void UHexGridManager::ApplySpecialTiles()
 {
     for (const FHexAxialCoordinates &C : ShopTiles)
     {
-        if (AHexTile *T = GetHexTileAt(C))
+        const int32 Index = GetTileIndex(C);
+        if (HasTileAtIndex(Index))
         {
-            T->SetTileType(EHexTileType::Shop);
+            SetTileType(C, EHexTileType::Shop);
 #if WITH_EDITOR
-            T->SetActorLabel(FString::Printf(TEXT("Shop (%d,%d)"), C.Q, C.R));
+            if (AHexTile *T = GetHexTileAtIndex(Index))
+                T->SetActorLabel(FString::Printf(TEXT("Shop (%d,%d)"), C.Q, C.R));
 #endif
         }
         else
         {
-            UE_LOG(LogTemp, Warning, TEXT("[Hex] Shop coord inconnue (%d,%d)"), C.Q, C.R);
+            UE_LOG(LogHexGrid, Warning, TEXT("[Hex] Shop coord inconnue (%d,%d)"), C.Q, C.R);
         }
     }
     for (const FHexAxialCoordinates& C : EnemyTiles)
-    if (AHexTile* T = GetHexTileAt(C))
-        T->SetTileType(EHexTileType::Enemy);
+        SetTileType(C, EHexTileType::Enemy);
 }
 
-FVector UHexGridManager::ComputeTileSpawnPosition(int32 Q, int32 R) const
+EHexTileType UHexGridManager::GetTileType(const FHexAxialCoordinates &Coords) const
+{
+    const int32 Index = GetTileIndex(Coords);
+    return HasTileAtIndex(Index) ? TileTypes[Index] : EHexTileType::Normal;
+}
+
+void UHexGridManager::SetTileType(const FHexAxialCoordinates &Coords, EHexTileType NewType)
+{
+    const int32 Index = GetTileIndex(Coords);
+    if (!HasTileAtIndex(Index))
+        return;
+
+    if (AHexTile *T = GetHexTileAtIndex(Index))
+        T->SetTileType(NewType);
+
+    if (TileTypes[Index] == NewType)
+        return;
+    TileTypes[Index] = NewType;
+    const uint8 OldCost = TileMoveCosts[Index];
+    TileMoveCosts[Index] = GetDefaultMoveCost(NewType);
+    UpdateMinMoveCost(OldCost, TileMoveCosts[Index]);
+    SetInstanceData(Index, HexInstanceData::Type, float(NewType));
+    NotifyGridChanged(Index);
+}
+
+int32 UHexGridManager::GetTileMoveCost(const FHexAxialCoordinates &Coords) const
+{
+    const int32 Index = GetTileIndex(Coords);
+    return HasTileAtIndex(Index) ? TileMoveCosts[Index] : 0;
+}
+
+void UHexGridManager::SetTileMoveCost(const FHexAxialCoordinates &Coords, int32 NewCost)
+{
+    const int32 Index = GetTileIndex(Coords);
+    if (!HasTileAtIndex(Index))
+        return;
+
+    const uint8 Cost = uint8(FMath::Clamp(NewCost, 0, 255));
+    const uint8 OldCost = TileMoveCosts[Index];
+    if (OldCost == Cost)
+        return;
+    TileMoveCosts[Index] = Cost;
+    UpdateMinMoveCost(OldCost, Cost);
+    NotifyGridChanged(Index);
+}
+
+uint8 UHexGridManager::GetDefaultMoveCost(EHexTileType Type) const
+{
+    const uint8 *Cost = MoveCostByType.Find(Type);
+    return Cost ? *Cost : 1;
+}
+
+void UHexGridManager::RebuildMoveCosts()
+{
+    for (TConstSetBitIterator<> It(TilePresent); It; ++It)
+        TileMoveCosts[It.GetIndex()] = GetDefaultMoveCost(TileTypes[It.GetIndex()]);
+    RecomputeMinMoveCost();
+}
+
+void UHexGridManager::RecomputeMinMoveCost()
+{
+    // O(N) : rebuilds et cas où la dernière tuile au minimum le quitte
+    int32 Min = MAX_int32;
+    int32 Count = 0;
+    for (TConstSetBitIterator<> It(TilePresent); It; ++It)
+    {
+        const int32 Cost = TileMoveCosts[It.GetIndex()];
+        if (Cost == 0 || Cost > Min)
+            continue;
+        Count = (Cost == Min) ? Count + 1 : 1;
+        Min = Cost;
+    }
+    MinMoveCost = (Min == MAX_int32) ? 1 : Min;
+    MinMoveCostTiles = Count;
+}
+
+void UHexGridManager::UpdateMinMoveCost(uint8 OldCost, uint8 NewCost)
+{
+    // Le coût est déjà écrit : un rescan éventuel le voit
+    if (OldCost > 0 && OldCost == MinMoveCost && MinMoveCostTiles > 0 && --MinMoveCostTiles == 0)
+    {
+        RecomputeMinMoveCost();
+        return;
+    }
+    if (NewCost == 0)
+        return;
+    if (MinMoveCostTiles == 0 || NewCost < MinMoveCost)
+    {
+        MinMoveCost = NewCost;
+        MinMoveCostTiles = 1;
+    }
+    else if (NewCost == MinMoveCost)
+    {
+        ++MinMoveCostTiles;
+    }
+}
+
+bool UHexGridManager::GetTileWorldLocation(const FHexAxialCoordinates &Coords, FVector &OutLocation) const
+{
+    const int32 Index = GetTileIndex(Coords);
+    if (!HasTileAtIndex(Index))
+        return false;
+    OutLocation = GetTileWorldLocationAtIndex(Index);
+    return true;
+}
+
+FVector UHexGridManager::GetTileWorldLocationAtIndex(int32 Index) const
+{
+    int32 Col = 0, Row = 0;
+    AxialToSpawnIndex(TileCoords[Index], Col, Row);
+    const FVector2D XY = ComputeTileXY(Col, Row);
+    return FVector(XY.X, XY.Y, TileHeights[Index]);
+}
+
+void UHexGridManager::SetTileHighlighted(const FHexAxialCoordinates &Coords, bool bHighlighted)
+{
+    const int32 Index = GetTileIndex(Coords);
+    if (!HasTileAtIndex(Index))
+        return;
+
+    if (AHexTile *T = GetHexTileAtIndex(Index))
+        T->SetHighlighted(bHighlighted);
+
+    SetInstanceData(Index, HexInstanceData::Highlight, bHighlighted ? 1.f : 0.f);
+    SetInstanceData(Index, HexInstanceData::Elevation, bHighlighted ? InstancedHighlightLiftZ : 0.f);
+}
+
+void UHexGridManager::SetTileVisibleAtIndex(int32 Index, bool bVisible)
+{
+    if (!HasTileAtIndex(Index) || TileVisible[Index] == bVisible)
+        return;
+    TileVisible[Index] = bVisible;
+
+    if (AHexTile *T = GetHexTileAtIndex(Index))
+    {
+        T->SetActorHiddenInGame(!bVisible);
+        T->SetActorEnableCollision(bVisible);
+    }
+    SetInstanceData(Index, HexInstanceData::Visible, bVisible ? 1.f : 0.f);
+}
+
+int32 UHexGridManager::GetTileIndexFromInstance(int32 InstanceIndex) const
+{
+    return InstanceTileIndices.IsValidIndex(InstanceIndex) ? InstanceTileIndices[InstanceIndex] : INDEX_NONE;
+}
+
+void UHexGridManager::ResetTileInstances()
+{
+    AActor *Owner = GetOwner();
+    if (!TileInstances && Owner)
+    {
+        TileInstances = NewObject<UHierarchicalInstancedStaticMeshComponent>(Owner, TEXT("HexTileInstances"), RF_Transient);
+        if (USceneComponent *Root = Owner->GetRootComponent())
+            TileInstances->SetupAttachment(Root);
+        else
+            Owner->SetRootComponent(TileInstances);
+
+        // Les instances sont placées en coordonnées monde
+        TileInstances->SetUsingAbsoluteLocation(true);
+        TileInstances->SetUsingAbsoluteRotation(true);
+        TileInstances->SetUsingAbsoluteScale(true);
+        TileInstances->SetWorldTransform(FTransform::Identity);
+
+        // Requêtes curseur uniquement (canal Visibility)
+        TileInstances->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+        TileInstances->SetCollisionResponseToAllChannels(ECR_Ignore);
+        TileInstances->SetCollisionResponseToChannel(ECC_Visibility, ECR_Block);
+
+        TileInstances->RegisterComponent();
+        Owner->AddInstanceComponent(TileInstances);
+    }
+    if (!TileInstances)
+        return;
+
+    TileInstances->ClearInstances();
+    TileInstances->SetStaticMesh(InstancedTileMesh);
+    if (InstancedTileMaterial)
+        TileInstances->SetMaterial(0, InstancedTileMaterial);
+    TileInstances->SetNumCustomDataFloats(HexInstanceData::Num);
+}
+
+void UHexGridManager::SetInstanceData(int32 Index, int32 Slot, float Value)
+{
+    const int32 Instance = TileInstanceIds.IsValidIndex(Index) ? TileInstanceIds[Index] : INDEX_NONE;
+    if (Instance == INDEX_NONE || !TileInstances)
+        return;
+
+    TileInstances->SetCustomDataValue(Instance, Slot, Value, /*bMarkRenderStateDirty*/ false);
+    if (!bInstanceDataDirty)
+    {
+        bInstanceDataDirty = true;
+        SetComponentTickEnabled(true);
+    }
+}
+
+void UHexGridManager::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    if (bInstanceDataDirty && TileInstances)
+        TileInstances->MarkRenderStateDirty();
+    bInstanceDataDirty = false;
+
+    // Progression une fois par frame pendant la génération, puis plus de tick
+    if (bGenerating)
+    {
+        OnGenerationProgress.Broadcast(GetGenerationProgress());
+        return;
+    }
+    SetComponentTickEnabled(false);
+}
+
+HexMath::FLayout UHexGridManager::GetWorldLayout() const
 {
     // Placement monde EXISTANT conservé
-    const float HexWidth = TileSize * 2.0f;
-    const float HexHeight = TileSize * YSpacingFactor;
-    const float XOffset = Q * HexWidth * XSpacingFactor;
-    const float YOffset = R * HexHeight;
+    const float StepY = TileSize * YSpacingFactor;
+    HexMath::FLayout Layout;
+    Layout.StepX = TileSize * 2.0f * XSpacingFactor;
+    Layout.StepY = StepY;
+    Layout.Shift = StepY * RowOffsetFactor;
+    Layout.Origin = HexMath::FVec2{float(GridOrigin.X + GlobalXYNudge.X), float(GridOrigin.Y + GlobalXYNudge.Y)};
+    return Layout;
+}
+
+FVector2D UHexGridManager::ComputeTileXY(int32 Q, int32 R) const
+{
+    const HexMath::FLayout Layout = GetWorldLayout();
+    const HexMath::FVec2 XY = HexMath::DispatchOffset(bOffsetOnQ, [&](auto Convention)
+    {
+        return HexMath::OffsetToWorld<decltype(Convention)>(Layout, HexMath::FOffset{Q, R});
+    });
+    return FVector2D(XY.X, XY.Y);
+}
 
-    const bool bIsOdd = bOffsetOnQ ? (Q & 1) : (R & 1);
-    const float RowShift = bIsOdd ? (HexHeight * RowOffsetFactor) : 0.f;
+bool UHexGridManager::WorldToHex(const FVector &WorldLocation, FHexAxialCoordinates &OutCoords) const
+{
+    // Centre le plus proche (voisinage 3x3) : exact quel que soit XSpacingFactor/YSpacingFactor/RowOffsetFactor
+    const HexMath::FLayout Layout = GetWorldLayout();
+    const HexMath::FVec2 P{float(WorldLocation.X), float(WorldLocation.Y)};
+    HexMath::FCoord Coords;
+    const bool bInside = HexMath::DispatchOffset(bOffsetOnQ, [&](auto Convention)
+    {
+        return HexMath::WorldToHex<decltype(Convention)>(Layout, P, Coords);
+    });
+    if (!bInside)
+        return false;
+
+    OutCoords = FHexAxialCoordinates(Coords);
+    return HasTileAt(OutCoords);
+}
+
+bool UHexGridManager::PickTileFromRay(const FVector &RayOrigin, const FVector &RayDirection, FHexAxialCoordinates &OutCoords) const
+{
+    if (FMath::IsNearlyZero(RayDirection.Z))
+        return false;
+
+    auto IntersectZ = [&](float PlaneZ, FVector &OutPoint)
+    {
+        const float T = (PlaneZ - RayOrigin.Z) / RayDirection.Z;
+        OutPoint = RayOrigin + RayDirection * T;
+        return T >= 0.f;
+    };
+
+    // 1) Plan de référence de la grille
+    FVector Hit;
+    if (!IntersectZ(GridOrigin.Z + TileZOffset, Hit) || !WorldToHex(Hit, OutCoords))
+        return false;
 
-    float FinalX = GridOrigin.X + XOffset + GlobalXYNudge.X;
-    float FinalY = GridOrigin.Y + YOffset + RowShift + GlobalXYNudge.Y;
+    // 2) Les tuiles suivent le terrain : une reprojection à la hauteur de la case trouvée
+    const int32 Index = GetTileIndex(OutCoords);
+    FVector Refined;
+    FHexAxialCoordinates RefinedCoords;
+    if (IntersectZ(TileHeights[Index], Refined) && WorldToHex(Refined, RefinedCoords))
+        OutCoords = RefinedCoords;
+    return true;
+}
+
+FVector UHexGridManager::ComputeTileSpawnPosition(int32 Q, int32 R) const
+{
+    const FVector2D XY = ComputeTileXY(Q, R);
+    float FinalX = XY.X;
+    float FinalY = XY.Y;
     float FinalZ = GridOrigin.Z;
 
     const FVector Base(FinalX, FinalY, FinalZ);
@@ -185,17 +927,9 @@ FVector UHexGridManager::ComputeTileSpawnPosition(int32 Q, int32 R) const
 
 bool UHexGridManager::TryComputeTileSpawnPosition(int32 Q, int32 R, FVector &OutLocation) const
 {
-    // Placement monde EXISTANT conservé
-    const float HexWidth = TileSize * 2.0f;
-    const float HexHeight = TileSize * YSpacingFactor;
-    const float XOffset = Q * HexWidth * XSpacingFactor;
-    const float YOffset = R * HexHeight;
-
-    const bool bIsOdd = bOffsetOnQ ? (Q & 1) : (R & 1);
-    const float RowShift = bIsOdd ? (HexHeight * RowOffsetFactor) : 0.f;
-
-    float FinalX = GridOrigin.X + XOffset + GlobalXYNudge.X;
-    float FinalY = GridOrigin.Y + YOffset + RowShift + GlobalXYNudge.Y;
+    const FVector2D XY = ComputeTileXY(Q, R);
+    float FinalX = XY.X;
+    float FinalY = XY.Y;
     float FinalZ = GridOrigin.Z;
 
     const FVector Base(FinalX, FinalY, FinalZ);
@@ -227,99 +961,174 @@ bool UHexGridManager::TryComputeTileSpawnPosition(int32 Q, int32 R, FVector &Out
      */
     if (!bHit)
     {
-        UE_LOG(LogTemp, Verbose, TEXT("[HexGrid] (%d,%d): no ground hit"), Q, R);
+        UE_LOG(LogHexGrid, Verbose, TEXT("[HexGrid] (%d,%d): no ground hit"), Q, R);
         return false;
     }
 
-    const AActor *HitA = Hit.GetActor();
-    if (bSkipTilesOverFloor)
-    {
-        if (!HitA)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("[HexGrid] (%d,%d): hit no actor -> skip"), Q, R);
-            return false;
-        }
-        if (HitA->ActorHasTag(FloorTag))
-        {
-            UE_LOG(LogTemp, Warning, TEXT("[HexGrid] (%d,%d): Floor tag on %s -> skip"), Q, R, *HitA->GetName());
-            return false;
-        }
-    }
+    if (!AcceptGroundHit(Q, R, Hit, FinalZ))
+        return false;
 
-    FinalZ = Hit.Location.Z + TileZOffset;
     OutLocation = FVector(FinalX, FinalY, FinalZ);
     return true;
 }
 
-// -------- Mapping Offset -> Axial standard -> Doubled-Q --------
+// -------- Mapping Offset -> Doubled-Q (cf. HexMath::FOddQ / FOddR) --------
+
+FHexAxialCoordinates UHexGridManager::MapSpawnIndexToAxial(int32 Col, int32 Row) const
+{
+    // Col/Row = indices utilisés par le placement existant
+    return HexMath::DispatchOffset(bOffsetOnQ, [&](auto Offset)
+    {
+        return FHexAxialCoordinates(HexMath::OffsetToDoubled<decltype(Offset)>(Col, Row));
+    });
+}
+
+bool UHexGridManager::AxialToSpawnIndex(const FHexAxialCoordinates &Coords, int32 &OutCol, int32 &OutRow) const
+{
+    return AxialToSpawnIndex(Coords, bOffsetOnQ, OutCol, OutRow);
+}
 
-static FORCEINLINE int32 FloorDiv2_Int(int32 x)
+bool UHexGridManager::AxialToSpawnIndex(const FHexAxialCoordinates &Coords, bool bInOffsetOnQ, int32 &OutCol, int32 &OutRow)
 {
-    // floor(x/2) pour entiers signés
-    return (x >= 0) ? (x >> 1) : -((-x + 1) >> 1);
+    // Labels doubled-q : Q toujours pair
+    HexMath::FOffset Offset;
+    const bool bValid = HexMath::DispatchOffset(bInOffsetOnQ, [&](auto Convention)
+    {
+        return HexMath::DoubledToOffset<decltype(Convention)>(Coords.ToHexMath(), Offset);
+    });
+    OutCol = Offset.Col;
+    OutRow = Offset.Row;
+    return bValid;
 }
 
-FHexAxialCoordinates UHexGridManager::MapSpawnIndexToAxial(int32 Col, int32 Row) const
+// ---------------------------------------------------------------
+
+int32 UHexGridManager::GetTileIndex(const FHexAxialCoordinates &Coords) const
 {
-    // Col/Row = indices utilisés par TON placement existant
-    // Convertit Offset → axial standard, puis axial → doubled-q
+    return ComputeTileIndex(Coords, IndexedRadius, bOffsetOnQ);
+}
 
-    int32 q_ax = 0;
-    int32 r_ax = 0;
+int32 UHexGridManager::ComputeTileIndex(const FHexAxialCoordinates &Coords, int32 Radius, bool bInOffsetOnQ)
+{
+    // Forme close de HexMath::TGridConvention ; -1 (INDEX_NONE) hors grille
+    return HexMath::DispatchConvention(bInOffsetOnQ, Radius, [&](const auto &Indexer)
+    {
+        return Indexer.IndexOf(Coords.ToHexMath());
+    });
+}
+
+FHexAxialCoordinates UHexGridManager::GetTileCoords(int32 Index) const
+{
+    return TileCoords[Index];
+}
 
-    if (bOffsetOnQ)
+void UHexGridManager::ResetTileStorage(int32 Radius)
+{
+    IndexedRadius = Radius;
+    CachedSnapshot.Reset();
+    const int32 Count = (Radius >= 0) ? 3 * Radius * (Radius + 1) + 1 : 0;
+
+    TileActors.Reset();
+    TileActors.SetNumZeroed(Count);
+    TileTypes.Reset();
+    TileTypes.Init(EHexTileType::Normal, Count);
+    TileHeights.Reset();
+    TileHeights.SetNumZeroed(Count);
+    NeighborMasks.Reset();
+    NeighborMasks.SetNumZeroed(Count);
+    TileMoveCosts.Reset();
+    TileMoveCosts.Init(1, Count);
+    MinMoveCost = 1;
+    MinMoveCostTiles = 0;
+    TilePresent.Init(false, Count);
+    TileVisible.Init(false, Count);
+    TileInstanceIds.Init(INDEX_NONE, Count);
+    InstanceTileIndices.Reset();
+    if (Count == 0 && TileInstances)
+        TileInstances->ClearInstances();
+
+    // Les coordonnées de chaque index sont fixes pour un rayon donné
+    TileCoords.Reset();
+    TileCoords.SetNumUninitialized(Count);
+    for (int32 Col = -Radius; Col <= Radius; ++Col)
     {
-        // Colonnes décalées (pointy-top). Odd-Q
-        // axial: q = col ; r = row - floor(col/2)
-        q_ax = Col;
-        r_ax = Row - FloorDiv2_Int(Col);
+        const int32 RowMin = FMath::Max(-Radius, -Col - Radius);
+        const int32 RowMax = FMath::Min(Radius, -Col + Radius);
+        for (int32 Row = RowMin; Row <= RowMax; ++Row)
+        {
+            const FHexAxialCoordinates A = MapSpawnIndexToAxial(Col, Row);
+            TileCoords[GetTileIndex(A)] = A;
+        }
     }
-    else
+}
+
+void UHexGridManager::RebuildNeighborMasks()
+{
+    for (int32 Index = 0; Index < TileCoords.Num(); ++Index)
     {
-        // Lignes décalées (flat-top). Odd-R
-        // axial: q = col - floor(row/2) ; r = row
-        q_ax = Col - FloorDiv2_Int(Row);
-        r_ax = Row;
+        uint8 Mask = 0;
+        if (TilePresent[Index])
+        {
+            const FHexAxialCoordinates C = TileCoords[Index];
+            for (int32 Dir = 0; Dir < 6; ++Dir)
+            {
+                const int32 N = GetTileIndex({C.Q + HexMath::NeighborDQ[Dir], C.R + HexMath::NeighborDR[Dir]});
+                if (N != INDEX_NONE && TilePresent[N])
+                    Mask |= uint8(1u << Dir);
+            }
+        }
+        NeighborMasks[Index] = Mask;
     }
+}
 
-    // Doubled-Q: q' = 2*q ; r' = r
-    return FHexAxialCoordinates{q_ax * 2, r_ax};
+void UHexGridManager::ForEachTile(TFunctionRef<void(const FHexAxialCoordinates &, AHexTile *)> Fn) const
+{
+    for (TConstSetBitIterator<> It(TilePresent); It; ++It)
+    {
+        const int32 Index = It.GetIndex();
+        Fn(TileCoords[Index], GetHexTileAtIndex(Index));
+    }
 }
 
-// ---------------------------------------------------------------
+AHexTile *UHexGridManager::GetHexTileAtIndex(int32 Index) const
+{
+    AHexTile *T = TileActors[Index];
+    return IsValid(T) ? T : nullptr;
+}
 
 AHexTile *UHexGridManager::GetHexTileAt(const FHexAxialCoordinates &Coords) const
 {
-    if (const TWeakObjectPtr<AHexTile> *Found = TilesMap.Find(Coords))
-        return Found->IsValid() ? Found->Get() : nullptr;
-    return nullptr;
+    const int32 Index = GetTileIndex(Coords);
+    return Index != INDEX_NONE ? GetHexTileAtIndex(Index) : nullptr;
 }
 
 TArray<FHexAxialCoordinates> UHexGridManager::GetNeighbors(const FHexAxialCoordinates &C) const
 {
     TArray<FHexAxialCoordinates> Out;
     Out.Reserve(6);
-    for (int i = 0; i < 6; ++i)
-    {
-        const FHexAxialCoordinates N{C.Q + GDQ6[i].Q, C.R + GDQ6[i].R};
-        if (GetHexTileAt(N))
-            Out.Add(N);
-
-        // Log ciblé sur la tuile problématique
-        if (C.Q == -8 && C.R == -1)
-        {
-            const bool bHas = GetHexTileAt(N) != nullptr;
-            UE_LOG(LogTemp, Warning, TEXT("[Dbg] GetNeighbors@(-8,-1) try (%d,%d) -> %d"), N.Q, N.R, bHas ? 1 : 0);
-        }
-    }
+    ForEachNeighbor(C, [&Out](const FHexAxialCoordinates &N)
+                    { Out.Add(N); });
     return Out;
 }
 
+int32 UHexGridManager::GetNeighborsInto(const FHexAxialCoordinates &C, TStaticArray<FHexAxialCoordinates, 6> &Out) const
+{
+    int32 Count = 0;
+    ForEachNeighbor(C, [&Out, &Count](const FHexAxialCoordinates &N)
+                    { Out[Count++] = N; });
+    return Count;
+}
+
+bool UHexGridManager::AreNeighbors(const FHexAxialCoordinates &A, const FHexAxialCoordinates &B) const
+{
+    const uint8 Mask = GetNeighborMaskAt(A);
+    const int32 Dir = HexMath::DirectionTo(A.ToHexMath(), B.ToHexMath());
+    return Dir >= 0 && (Mask & (1u << Dir)) != 0;
+}
+
 int32 UHexGridManager::AxialDistance(const FHexAxialCoordinates &A, const FHexAxialCoordinates &B) const
 {
-    const int32 dq = FMath::Abs(A.Q - B.Q);
-    const int32 dr = FMath::Abs(A.R - B.R);
-    return FMath::Max(dr, (dq + dr) / 2);
+    return HexMath::Distance(A.ToHexMath(), B.ToHexMath());
 }
 
 void UHexGridManager::BuildWorldNeighbors()
@@ -330,52 +1139,141 @@ void UHexGridManager::BuildWorldNeighbors()
     if (!World)
         return;
 
-    TMap<FHexAxialCoordinates, FVector> Pos;
-    for (TActorIterator<AHexTile> It(World); It; ++It)
-        if (IsValid(*It))
-            Pos.Add(It->GetAxialCoordinates(), It->GetActorLocation());
+    constexpr int32 K = 6;
 
-    for (const auto &ItA : Pos)
+    // Positions issues du stockage dense : valable aussi sans acteurs (mode Instanced)
+    TArray<int32> Tiles;
+    TArray<FVector2D> Pos;
+    Tiles.Reserve(TileCoords.Num());
+    Pos.Reserve(TileCoords.Num());
+    for (TConstSetBitIterator<> It(TilePresent); It; ++It)
     {
-        const FHexAxialCoordinates AKey = ItA.Key;
-        const FVector APos = ItA.Value;
+        Tiles.Add(It.GetIndex());
+        Pos.Add(FVector2D(GetTileWorldLocationAtIndex(It.GetIndex())));
+    }
+    const int32 N = Tiles.Num();
+    if (N == 0)
+        return;
 
-        struct FNeighborDist
-        {
-            FHexAxialCoordinates Key;
-            float D2;
-        };
-        TArray<FNeighborDist> D;
-        D.Reserve(16);
+    // Grille de seaux uniforme : côté = plus grand pas du layout, ~1 tuile par seau
+    const float BucketSize = FMath::Max3(TileSize * 2.0f * XSpacingFactor, TileSize * YSpacingFactor, 1.0f);
+    FBox2D Bounds(Pos);
+    const int32 BX = FMath::FloorToInt32((Bounds.Max.X - Bounds.Min.X) / BucketSize) + 1;
+    const int32 BY = FMath::FloorToInt32((Bounds.Max.Y - Bounds.Min.Y) / BucketSize) + 1;
+
+    auto BucketOf = [&](const FVector2D &P, int32 &OutX, int32 &OutY)
+    {
+        OutX = FMath::Clamp(FMath::FloorToInt32((P.X - Bounds.Min.X) / BucketSize), 0, BX - 1);
+        OutY = FMath::Clamp(FMath::FloorToInt32((P.Y - Bounds.Min.Y) / BucketSize), 0, BY - 1);
+    };
+
+    // Tri par comptage : BucketStart[b]..BucketStart[b+1] = tuiles du seau b (format CSR)
+    TArray<int32> BucketStart;
+    BucketStart.SetNumZeroed(BX * BY + 1);
+    TArray<int32> BucketOfTile;
+    BucketOfTile.SetNumUninitialized(N);
+    for (int32 i = 0; i < N; ++i)
+    {
+        int32 X, Y;
+        BucketOf(Pos[i], X, Y);
+        BucketOfTile[i] = Y * BX + X;
+        ++BucketStart[BucketOfTile[i] + 1];
+    }
+    for (int32 b = 0; b < BX * BY; ++b)
+        BucketStart[b + 1] += BucketStart[b];
+
+    TArray<int32> BucketItems;
+    BucketItems.SetNumUninitialized(N);
+    {
+        TArray<int32> Fill(BucketStart.GetData(), BX * BY);
+        for (int32 i = 0; i < N; ++i)
+            BucketItems[Fill[BucketOfTile[i]]++] = i;
+    }
 
-        for (const auto &ItB : Pos)
+    // k plus proches par anneaux de seaux croissants, en parallèle (lecture seule + sortie par tuile)
+    TArray<int32> Nearest;
+    Nearest.Init(INDEX_NONE, N * K);
+    ParallelFor(N, [&](int32 A)
+    {
+        int32 BestIdx[K];
+        float BestD2[K];
+        int32 Found = 0;
+
+        const FVector2D P = Pos[A];
+        int32 CX, CY;
+        BucketOf(P, CX, CY);
+
+        const int32 MaxRing = FMath::Max(BX, BY);
+        for (int32 Ring = 0; Ring <= MaxRing; ++Ring)
         {
-            if (ItB.Key == AKey)
-                continue;
-            const float d2 = (ItB.Value - APos).SizeSquared2D(); // float sûr
-            D.Add({ItB.Key, d2});
-        }
+            for (int32 Y = CY - Ring; Y <= CY + Ring; ++Y)
+            {
+                if (Y < 0 || Y >= BY)
+                    continue;
+                // Seulement le contour de l'anneau (l'intérieur a déjà été vu)
+                const bool bEdgeRow = (Y == CY - Ring || Y == CY + Ring);
+                const int32 Step = bEdgeRow ? 1 : FMath::Max(1, 2 * Ring);
+                for (int32 X = CX - Ring; X <= CX + Ring; X += Step)
+                {
+                    if (X < 0 || X >= BX)
+                        continue;
+                    const int32 B = Y * BX + X;
+                    for (int32 It = BucketStart[B]; It < BucketStart[B + 1]; ++It)
+                    {
+                        const int32 O = BucketItems[It];
+                        if (O == A)
+                            continue;
+                        const float D2 = FVector2D::DistSquared(P, Pos[O]);
+                        if (Found == K && (D2 > BestD2[K - 1] || (D2 == BestD2[K - 1] && O > BestIdx[K - 1])))
+                            continue;
+
+                        // Insertion triée (distance, puis index pour un résultat déterministe)
+                        int32 Slot = Found < K ? Found++ : K - 1;
+                        while (Slot > 0 && (D2 < BestD2[Slot - 1] || (D2 == BestD2[Slot - 1] && O < BestIdx[Slot - 1])))
+                        {
+                            BestD2[Slot] = BestD2[Slot - 1];
+                            BestIdx[Slot] = BestIdx[Slot - 1];
+                            --Slot;
+                        }
+                        BestD2[Slot] = D2;
+                        BestIdx[Slot] = O;
+                    }
+                }
+            }
 
-        D.Sort([](const FNeighborDist &L, const FNeighborDist &R)
-               { return L.D2 < R.D2; });
+            // Tout point hors des anneaux vus est à plus de Ring * BucketSize
+            const float Reach = Ring * BucketSize;
+            if (Found == K && BestD2[K - 1] <= Reach * Reach)
+                break;
+        }
 
-        TArray<FHexAxialCoordinates> Neigh;
-        const int32 Count = FMath::Min(6, D.Num());
-        Neigh.Reserve(Count);
-        for (int32 i = 0; i < Count; ++i)
-            Neigh.Add(D[i].Key);
+        for (int32 i = 0; i < Found; ++i)
+            Nearest[A * K + i] = BestIdx[i];
+    });
 
-        WorldNeighbors.Add(AKey, MoveTemp(Neigh));
+    WorldNeighbors.Reserve(N);
+    for (int32 A = 0; A < N; ++A)
+    {
+        TArray<FHexAxialCoordinates> &Neigh = WorldNeighbors.Add(FHexCoordKey(TileCoords[Tiles[A]]));
+        Neigh.Reserve(K);
+        for (int32 i = 0; i < K && Nearest[A * K + i] != INDEX_NONE; ++i)
+            Neigh.Add(TileCoords[Tiles[Nearest[A * K + i]]]);
     }
 
 #if !UE_BUILD_SHIPPING
-    UE_LOG(LogTemp, Warning, TEXT("[Hex] WorldNeighbors built for %d tiles"), WorldNeighbors.Num());
+    UE_LOG(LogHexGrid, Log, TEXT("[Hex] WorldNeighbors built for %d tiles (%dx%d buckets)"), WorldNeighbors.Num(), BX, BY);
 #endif
 }
 
 void UHexGridManager::GetNeighborsByWorld(const FHexAxialCoordinates &From, TArray<FHexAxialCoordinates> &Out) const
 {
-    if (const TArray<FHexAxialCoordinates> *Found = WorldNeighbors.Find(From))
+    // Label hors clé compacte : ce n'est pas une tuile de la grille (et la clé tronquée pourrait en désigner une)
+    if (!FHexCoordKey::CanPack(From))
+    {
+        Out.Reset();
+        return;
+    }
+    if (const TArray<FHexAxialCoordinates> *Found = WorldNeighbors.Find(FHexCoordKey(From)))
         Out = *Found;
     else
         Out.Reset();
@@ -384,15 +1282,17 @@ void UHexGridManager::GetNeighborsByWorld(const FHexAxialCoordinates &From, TArr
 void UHexGridManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
     // Évite déréférencer des acteurs pendant teardown
-    TilesMap.Empty();
+    CancelGeneration();
+    ResetTileStorage(INDEX_NONE);
     WorldNeighbors.Empty();
     Super::EndPlay(EndPlayReason);
 }
 
 void UHexGridManager::BeginDestroy()
 {
-    // Sécurité hot-reload / editor
-    TilesMap.Empty();
+    // Sécurité hot-reload / editor (la HISM peut déjà être en cours de destruction)
+    TileInstances = nullptr;
+    ResetTileStorage(INDEX_NONE);
     WorldNeighbors.Empty();
     Super::BeginDestroy();
 }
@@ -0,0 +1,231 @@
+// HexMathTests.cpp
+//
+// Tests à la compilation de HexMath.h : un static_assert qui échoue casse la build du module.
+// Banc hors moteur (C++ standard seul, même fichier) :
+//   g++ -std=c++20 -O2 -DHEX_MATH_BENCH -IPublic Private/HexMathTests.cpp -o HexMathBench && ./HexMathBench
+// Dans le module, HEX_MATH_BENCH n'est pas défini : seuls les static_assert sont compilés.
+
+#include "HexMath.h"
+#include <type_traits>
+
+namespace HexMath
+{
+	namespace Tests
+	{
+		constexpr bool NeighborsAreAtDistanceOne()
+		{
+			for (int32 Dir = 0; Dir < 6; ++Dir)
+			{
+				const FCoord C{4, -3};
+				const FCoord N = Neighbor(C, Dir);
+				if (Distance(C, N) != 1 || DirectionTo(C, N) != Dir || Neighbor(N, OppositeDir(Dir)) != C || !IsValid(N))
+					return false;
+				if (Rotate60(Direction(Dir)) != Direction((Dir + 1) % 6))
+					return false;
+			}
+			return true;
+		}
+
+		constexpr bool RingsAreClosedLoops(int32 MaxRadius)
+		{
+			const FCoord Center{-6, 2};
+			for (int32 Radius = 1; Radius <= MaxRadius; ++Radius)
+			{
+				const int32 Num = RingSize(Radius);
+				for (int32 I = 0; I < Num; ++I)
+				{
+					const FCoord C = RingAt(Center, Radius, I);
+					if (Distance(Center, C) != Radius || !AreNeighbors(C, RingAt(Center, Radius, (I + 1) % Num)))
+						return false;
+				}
+				int32 Count = 0;
+				bool bSame = true;
+				ForEachInRing(Center, Radius, [&](const FCoord& C) { bSame = bSame && C == RingAt(Center, Radius, Count++); });
+				if (!bSame || Count != Num)
+					return false;
+			}
+			return SpiralAt(Center, 0) == Center && SpiralAt(Center, SpiralSize(MaxRadius) - 1) == RingAt(Center, MaxRadius, RingSize(MaxRadius) - 1);
+		}
+
+		constexpr bool LinesAreContiguous()
+		{
+			const FCoord A{-8, 3};
+			const FCoord Ends[] = {{10, -2}, {-8, -5}, {2, 4}, {-8, 3}, {0, 0}, {14, -7}};
+			for (const FCoord& B : Ends)
+			{
+				const int32 N = Distance(A, B);
+				if (LineAt(A, B, 0) != A || LineAt(A, B, N) != B)
+					return false;
+				for (int32 I = 1; I <= N; ++I)
+					if (!AreNeighbors(LineAt(A, B, I - 1), LineAt(A, B, I)))
+						return false;
+			}
+			return true;
+		}
+
+		template <typename TOffset>
+		constexpr bool OffsetRoundTrips()
+		{
+			for (int32 Col = -5; Col <= 5; ++Col)
+				for (int32 Row = -5; Row <= 5; ++Row)
+				{
+					FOffset Back;
+					if (!DoubledToOffset<TOffset>(OffsetToDoubled<TOffset>(Col, Row), Back) || !(Back == FOffset{Col, Row}))
+						return false;
+				}
+			FOffset Unused;
+			return !DoubledToOffset<TOffset>(FCoord{1, 0}, Unused);
+		}
+
+		template <typename TOffset>
+		constexpr bool WorldRoundTrips()
+		{
+			const FLayout L{173.2f, 100.f, 50.f, FVec2{-40.f, 12.f}};
+			for (int32 Q = -6; Q <= 6; Q += 2)
+				for (int32 R = -3; R <= 3; ++R)
+				{
+					const FCoord C{Q, R};
+					FVec2 P = HexToWorld<TOffset>(L, C);
+					P.X += 20.f;
+					P.Y -= 15.f;
+					FCoord Back;
+					if (!WorldToHex<TOffset>(L, P, Back) || Back != C)
+						return false;
+				}
+			return true;
+		}
+
+		static_assert(FloorDiv2(-3) == -2 && FloorDiv2(-2) == -1 && FloorDiv2(3) == 1, "FloorDiv2");
+		static_assert(RoundToInt(-0.5) == 0 && RoundToInt(-0.6) == -1 && RoundToInt(2.5) == 3, "RoundToInt");
+		static_assert(Distance(FCoord{0, 0}, FCoord{4, -2}) == 2 && Distance(FCoord{-4, 0}, FCoord{2, -3}) == 3, "Distance");
+		static_assert(NeighborsAreAtDistanceOne(), "Neighbors / rotation");
+		static_assert(Rotate(FCoord{6, -1}, FCoord{2, 1}, 6) == FCoord{6, -1} && Rotate(FCoord{6, -1}, FCoord{2, 1}, -1) == Rotate(FCoord{6, -1}, FCoord{2, 1}, 5), "Rotate");
+		static_assert(RingSize(0) == 1 && SpiralSize(2) == 19, "Sizes");
+		static_assert(RingsAreClosedLoops(4), "Rings / spiral");
+		static_assert(LinesAreContiguous(), "Lines");
+		static_assert(OffsetRoundTrips<FOddQ>() && OffsetRoundTrips<FOddR>(), "Offset conversions");
+		static_assert(WorldRoundTrips<FOddQ>() && WorldRoundTrips<FOddR>(), "World conversions");
+
+		/** Chaque case de l'hexagone a un index distinct dans [0, TileCount), et rien au-delà */
+		template <typename TConvention>
+		constexpr bool TileIndexIsBijective(int32 Radius)
+		{
+			const int32 Count = TConvention::TileCount(Radius);
+			int32 Sum = 0;
+			int32 Seen = 0;
+			for (int32 Col = -Radius - 1; Col <= Radius + 1; ++Col)
+				for (int32 Row = -Radius - 1; Row <= Radius + 1; ++Row)
+				{
+					const FCoord C = OffsetToDoubled<typename TConvention::FOffsetConvention>(Col, Row);
+					const int32 Index = TConvention::TileIndex(C, Radius);
+					const bool bInside = Abs(Col) <= Radius && Abs(Row) <= Radius && Abs(Col + Row) <= Radius;
+					if (bInside != (Index >= 0) || Index >= Count)
+						return false;
+					if (Index >= 0)
+					{
+						Sum += Index;
+						++Seen;
+					}
+				}
+			return Seen == Count && Sum == Count * (Count - 1) / 2 && TConvention::TileIndex(FCoord{1, 0}, Radius) == -1;
+		}
+
+		static_assert(TileIndexIsBijective<FOddQGrid>(4) && TileIndexIsBijective<FOddRGrid>(4), "Tile index");
+		constexpr bool PackedKeysRoundTrip()
+		{
+			const FCoord Samples[] = {{0, 0}, {-2, 1}, {4, -3}, {-65536, 32767}, {65534, -32768}, {-400, 200}};
+			for (const FCoord& C : Samples)
+				if (!FPackedKey::CanPack(C) || FPackedKey::Pack(C).Unpack() != C)
+					return false;
+			return !FPackedKey::CanPack(FCoord{1, 0}) && !FPackedKey::CanPack(FCoord{0, 40000})
+				&& FPackedKey::Pack(FCoord{2, 1}).Hash() != FPackedKey::Pack(FCoord{2, 2}).Hash()
+				&& FPackedKey::Pack(FCoord{-2, 1}).TileIndex<FOddQGrid>(3) == FOddQGrid::TileIndex(FCoord{-2, 1}, 3);
+		}
+
+		static_assert(PackedKeysRoundTrip(), "Packed key");
+		static_assert(DispatchConvention(true, 3, [](const auto& Indexer) { return Indexer.NeighborIndexOf(FCoord{0, 0}, 3); })
+		              == FOddQGrid::TileIndex(FCoord{2, 0}, 3), "Indexer");
+		static_assert(!std::is_constructible_v<TTileIndexer<FOddQGrid>, int32>, "TTileIndexer ne s'obtient que par DispatchConvention");
+	}
+}
+
+#if defined(HEX_MATH_BENCH)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+	using namespace HexMath;
+
+	constexpr int32 SampleCount = 1 << 16;
+	constexpr int32 Repeats = 64;
+	constexpr int32 GridRadius = 50;
+
+	/** Coordonnées pseudo-aléatoires dans l'hexagone de rayon GridRadius (mêmes tirages à chaque lancement) */
+	std::vector<FCoord> MakeSamples()
+	{
+		std::vector<FCoord> Out;
+		Out.reserve(SampleCount);
+		uint32 State = 1337u;
+		while (int32(Out.size()) < SampleCount)
+		{
+			State = State * 1664525u + 1013904223u;
+			const int32 Col = int32(State >> 8) % (2 * GridRadius + 1) - GridRadius;
+			State = State * 1664525u + 1013904223u;
+			const int32 Row = int32(State >> 8) % (2 * GridRadius + 1) - GridRadius;
+			if (Col + Row >= -GridRadius && Col + Row <= GridRadius)
+				Out.push_back(OffsetToDoubled<FOddQ>(Col, Row));
+		}
+		return Out;
+	}
+
+	/** Meilleur temps par opération sur Repeats passes ; Sink empêche l'élimination du calcul */
+	template <typename FuncType>
+	void Run(const char* Name, const std::vector<FCoord>& Samples, FuncType&& Fn)
+	{
+		volatile std::int64_t Sink = 0;
+		double BestNs = 1e30;
+		for (int32 Pass = 0; Pass < Repeats; ++Pass)
+		{
+			std::int64_t Acc = 0;
+			const auto Start = std::chrono::steady_clock::now();
+			for (int32 I = 0; I < SampleCount; ++I)
+				Acc += Fn(Samples[I], Samples[(I * 7 + 3) % SampleCount]);
+			const auto End = std::chrono::steady_clock::now();
+			Sink = Sink + Acc;
+			BestNs = std::min(BestNs, std::chrono::duration<double, std::nano>(End - Start).count() / SampleCount);
+		}
+		std::printf("%-14s %7.2f ns/op\n", Name, BestNs);
+	}
+}
+
+int main()
+{
+	const std::vector<FCoord> Samples = MakeSamples();
+	const FLayout Layout{173.2f, 100.f, 50.f, FVec2{-40.f, 12.f}};
+
+	Run("Distance", Samples, [](const FCoord& A, const FCoord& B) { return Distance(A, B); });
+	Run("Neighbor x6", Samples, [](const FCoord& A, const FCoord&)
+	{
+		int32 Sum = 0;
+		for (int32 Dir = 0; Dir < 6; ++Dir)
+			Sum += Neighbor(A, Dir).Q;
+		return Sum;
+	});
+	Run("TileIndex", Samples, [](const FCoord& A, const FCoord&) { return FOddQGrid::TileIndex(A, GridRadius); });
+	Run("HexToWorld", Samples, [&](const FCoord& A, const FCoord&) { return int32(HexToWorld<FOddQ>(Layout, A).X); });
+	Run("WorldToHex", Samples, [&](const FCoord& A, const FCoord&)
+	{
+		FCoord Back;
+		return WorldToHex<FOddQ>(Layout, HexToWorld<FOddQ>(Layout, A), Back) ? Back.R : 0;
+	});
+	Run("LineAt (mid)", Samples, [](const FCoord& A, const FCoord& B) { return LineAt(A, B, Distance(A, B) / 2).R; });
+	Run("RingAt r=3", Samples, [](const FCoord& A, const FCoord&) { return RingAt(A, 3, 5).Q; });
+	Run("PackedKey", Samples, [](const FCoord& A, const FCoord&) { return int32(FPackedKey::Pack(A).Hash()); });
+	return 0;
+}
+
+#endif // HEX_MATH_BENCH
@@ -1,137 +1,1036 @@
 #include "HexPathFinder.h"
 #include "HexGridManager.h"
-#include "Algo/Reverse.h"
+#include "HexGridSnapshot.h"
+#include "HexFlowField.h"
+#include "HexMovementRange.h"
+#include "HexClusterGraph.h"
+#include "HexStats.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
+
+namespace
+{
+	// Tas min sur F, départage sur H (favorise les noeuds proches du but)
+	struct FOpenLess
+	{
+		template <typename T>
+		FORCEINLINE bool operator()(const T& A, const T& B) const
+		{
+			return A.F < B.F || (A.F == B.F && A.H < B.H);
+		}
+	};
+
+	/** Tampons d'un worker, gardés d'une requête à l'autre (un jeu par thread) */
+	struct FWorkerScratch
+	{
+		struct FNode
+		{
+			int32  G;
+			int32  Parent;
+			uint32 Generation;
+			bool   bClosed;
+		};
+		struct FEntry
+		{
+			int32 F;
+			int32 H;
+			int32 Index;
+		};
+
+		TArray<FNode>  Nodes;
+		TArray<FEntry> Heap;
+		uint32         Generation = 0;
+
+		void Begin(int32 Count)
+		{
+			if (Nodes.Num() != Count)
+			{
+				Nodes.Reset();
+				Nodes.SetNumZeroed(Count);
+				Generation = 0;
+			}
+			if (++Generation == 0)
+			{
+				for (FNode& N : Nodes)
+					N.Generation = 0;
+				Generation = 1;
+			}
+			Heap.Reset();
+		}
+	};
+
+	// Contrôle d'annulation tous les N pops
+	constexpr int32 CancelCheckInterval = 256;
+
+	/** Bloc d'un tableau en début de requête : s'il a changé à la fin (adresse ou capacité), la requête a alloué */
+	struct FBufferMark
+	{
+		const void* Data;
+		int32       Max;
+
+		template <typename ArrayType>
+		explicit FBufferMark(const ArrayType& Array) : Data(Array.GetData()), Max(Array.Max()) {}
+
+		template <typename ArrayType>
+		int32 Grew(const ArrayType& Array) const
+		{
+			return (Array.Max() > 0 && (Array.GetData() != Data || Array.Max() != Max)) ? 1 : 0;
+		}
+	};
+}
 
 UHexPathFinder::UHexPathFinder()
 {
 	PrimaryComponentTick.bCanEverTick = false;
 }
 
-void UHexPathFinder::GetValidNeighbors(const FHexAxialCoordinates& From,
-                                       TArray<FHexAxialCoordinates>& Out) const
+void UHexPathFinder::Init(UHexGridManager* InGrid)
+{
+	if (GridRef && GridChangedHandle.IsValid())
+		GridRef->OnGridChanged.Remove(GridChangedHandle);
+	GridChangedHandle.Reset();
+
+	GridRef = InGrid;
+	if (GridRef)
+		GridChangedHandle = GridRef->OnGridChanged.AddUObject(this, &UHexPathFinder::HandleGridChanged);
+	if (ClusterGraph)
+		ClusterGraph->MarkTileChanged(INDEX_NONE);
+}
+
+void UHexPathFinder::HandleGridChanged(int32 TileIndex)
+{
+	if (ClusterGraph)
+		ClusterGraph->MarkTileChanged(TileIndex);
+}
+
+bool ValidateHexPathAdjacency(TConstArrayView<FHexAxialCoordinates> Path, const TCHAR* Source, bool bAllowWait)
+{
+	for (int32 i = 1; i < Path.Num(); ++i)
+	{
+		const bool bWait = bAllowWait && Path[i] == Path[i - 1];
+		if (!bWait && !HexMath::AreNeighbors(Path[i - 1].ToHexMath(), Path[i].ToHexMath()))
+		{
+			ensureMsgf(false, TEXT("[%s] pas %d non adjacent : (%d,%d)->(%d,%d)"),
+			           Source, i, Path[i - 1].Q, Path[i - 1].R, Path[i].Q, Path[i].R);
+			return false;
+		}
+	}
+	return true;
+}
+
+bool UHexPathFinder::FindPathHierarchical(const FHexAxialCoordinates& Start, const FHexAxialCoordinates& Goal,
+                                          TArray<FHexAxialCoordinates>& OutPath)
 {
-	Out.Reset();
-	if (!GridRef) return;
-	Out = GridRef->GetNeighbors(From);
+	HEX_SCOPE(STAT_HexFindPathHierarchical, "Hex::FindPathHierarchical");
+	OutPath.Reset();
+	if (!GridRef) return false;
+
+	if (!ClusterGraph)
+		ClusterGraph = MakeShared<FHexClusterGraph>();
+	ClusterGraph->SetClusterSize(ClusterSize);
+	const bool bFound = ClusterGraph->FindPath(*GridRef, Start, Goal, MovementBudget, OutPath);
+	HEX_VALIDATE_PATH(OutPath, TEXT("HPA*"), false);
+	HexStats::RecordQuery({EHexQueryKind::Hierarchical, ClusterGraph->GetLastAbstractExpanded(), OutPath.Num(), false, bFound});
+	return bFound;
 }
 
 int32 UHexPathFinder::Heuristic(const FHexAxialCoordinates& A, const FHexAxialCoordinates& B) const
 {
-	// Heuristique admissible fournie par la grille (doubled-q / axial)
-	return GridRef ? GridRef->AxialDistance(A, B) : 0;
+	// Admissible : chaque pas restant coûte au moins le plus petit coût de la grille
+	return GridRef ? GridRef->AxialDistance(A, B) * GridRef->GetMinMoveCost() : 0;
+}
+
+void UHexPathFinder::BeginSearch(int32 IndexCount)
+{
+	if (Nodes.Num() != IndexCount)
+	{
+		// Seule allocation : quand la grille change de taille
+		Nodes.Reset();
+		Nodes.SetNumZeroed(IndexCount);
+		SearchGeneration = 0;
+	}
+
+	if (++SearchGeneration == 0)
+	{
+		// Rebouclage du compteur : on invalide tout une fois pour toutes
+		for (FNodeRecord& N : Nodes)
+			N.Generation = 0;
+		SearchGeneration = 1;
+	}
+
+	OpenHeap.Reset();
+}
+
+void UHexPathFinder::ReconstructPath(int32 GoalIndex, int32 Budget, TArray<FHexAxialCoordinates>& OutPath) const
+{
+	// G croît strictement le long du chemin : on saute la fin qui dépasse le budget (Start, G = 0, reste)
+	int32 Last = GoalIndex;
+	if (Budget > 0)
+		while (Nodes[Last].G > Budget)
+			Last = Nodes[Last].Parent;
+
+	int32 Len = 0;
+	for (int32 I = Last; I != INDEX_NONE; I = Nodes[I].Parent)
+		++Len;
+
+	OutPath.SetNumUninitialized(Len, EAllowShrinking::No);
+	for (int32 i = Len - 1, Cur = Last; i >= 0; --i, Cur = Nodes[Cur].Parent)
+		OutPath[i] = GridRef->GetTileCoords(Cur);
+	HEX_VALIDATE_PATH(OutPath, TEXT("A*"), false);
 }
 
-void UHexPathFinder::ReconstructPath(const TMap<FHexAxialCoordinates,FHexAxialCoordinates>& Parent,
-                                     const FHexAxialCoordinates& Start,
-                                     const FHexAxialCoordinates& Goal,
-                                     TArray<FHexAxialCoordinates>& OutPath)
+bool UHexPathFinder::EnsurePathTree(const FHexAxialCoordinates& Source)
+{
+	if (!GridRef) return false;
+
+	const int32 SourceIdx = GridRef->GetTileIndex(Source);
+	if (!GridRef->HasTileAtIndex(SourceIdx))
+	{
+		TreeSourceIndex = INDEX_NONE;
+		return false;
+	}
+
+	const uint32 Version = GridRef->GetGridVersion();
+	const int32 Count = GridRef->GetTileIndexCount();
+	if (SourceIdx == TreeSourceIndex && Version == TreeGridVersion && TreeCost.Num() == Count)
+		return true;
+
+	HEX_SCOPE(STAT_HexPathTree, "Hex::EnsurePathTree");
+	TreeSourceIndex = SourceIdx;
+	TreeGridVersion = Version;
+	TreeParent.Init(INDEX_NONE, Count);
+	TreeCost.Init(INDEX_NONE, Count);
+
+	// Dijkstra sans but (H = 0) : même tas que l'A*, entrées périmées ignorées au pop
+	OpenHeap.Reset();
+	TreeCost[SourceIdx] = 0;
+	OpenHeap.HeapPush(FOpenEntry{0, 0, SourceIdx}, FOpenLess());
+
+	int32 Expanded = 0;
+	GridRef->WithTileIndexer([&](const auto& Indexer)
+	{
+		while (OpenHeap.Num() > 0)
+		{
+			FOpenEntry Top;
+			OpenHeap.HeapPop(Top, FOpenLess(), EAllowShrinking::No);
+			if (Top.F != TreeCost[Top.Index])
+				continue;
+
+			const int32 CurIdx = Top.Index;
+			++Expanded;
+			GridRef->ForEachNeighborIndex(Indexer, CurIdx, [&](int32 NIdx, int32 /*Dir*/)
+			{
+				const uint8 Step = GridRef->GetTileMoveCostAtIndex(NIdx);
+				if (Step == 0)
+					return; // infranchissable
+
+				const int32 NewCost = Top.F + Step;
+				if (TreeCost[NIdx] != INDEX_NONE && TreeCost[NIdx] <= NewCost)
+					return;
+				TreeCost[NIdx] = NewCost;
+				TreeParent[NIdx] = CurIdx;
+				OpenHeap.HeapPush(FOpenEntry{NewCost, 0, NIdx}, FOpenLess());
+			});
+		}
+	});
+	HexStats::RecordQuery({EHexQueryKind::PathTree, Expanded, 0, false, true}); // un arbre, pas un chemin
+	return true;
+}
+
+bool UHexPathFinder::GetTreePathTo(const FHexAxialCoordinates& Goal, TArray<FHexAxialCoordinates>& OutPath) const
 {
 	OutPath.Reset();
-	FHexAxialCoordinates Cur = Goal;
-	OutPath.Add(Cur);
-	while (!(Cur == Start))
+	if (!GridRef || TreeSourceIndex == INDEX_NONE || TreeGridVersion != GridRef->GetGridVersion())
+		return false;
+
+	const int32 GoalIdx = GridRef->GetTileIndex(Goal);
+	if (!TreeCost.IsValidIndex(GoalIdx) || TreeCost[GoalIdx] == INDEX_NONE)
+		return false;
+
+	// Même troncature que ReconstructPath : dernière tuile payable avec MovementBudget
+	int32 Last = GoalIdx;
+	if (MovementBudget > 0)
+		while (TreeCost[Last] > MovementBudget)
+			Last = TreeParent[Last];
+
+	int32 Len = 0;
+	for (int32 I = Last; I != INDEX_NONE; I = TreeParent[I])
+		++Len;
+
+	OutPath.SetNumUninitialized(Len, EAllowShrinking::No);
+	for (int32 i = Len - 1, Cur = Last; i >= 0; --i, Cur = TreeParent[Cur])
+		OutPath[i] = GridRef->GetTileCoords(Cur);
+	HEX_VALIDATE_PATH(OutPath, TEXT("Tree"), false);
+	return true;
+}
+
+int32 UHexPathFinder::GetTreeCostTo(const FHexAxialCoordinates& Goal) const
+{
+	if (!GridRef || TreeSourceIndex == INDEX_NONE)
+		return INDEX_NONE;
+	const int32 GoalIdx = GridRef->GetTileIndex(Goal);
+	return TreeCost.IsValidIndex(GoalIdx) ? TreeCost[GoalIdx] : INDEX_NONE;
+}
+
+bool UHexPathFinder::ComputeMovementRange(const FHexAxialCoordinates& Origin, const FHexRangeRules& Rules, FHexMovementRange& OutRange)
+{
+	HEX_SCOPE(STAT_HexMovementRange, "Hex::ComputeMovementRange");
+	// Sans bKeepCosts, les coûts vivent dans un tampon du pathfinder et les parents ne sont pas tenus
+	TArray<int32>& Cost = Rules.bKeepCosts ? OutRange.CostToReach : RangeCostScratch;
+	const FBufferMark HeapMark(OpenHeap), ReachableMark(OutRange.Reachable);
+	const FBufferMark CostMark(Cost), ParentsMark(OutRange.Parents);
+
+	// Remise à zéro qui garde les blocs de la portée précédente
+	OutRange.OriginIndex = INDEX_NONE;
+	OutRange.GridVersion = 0;
+	OutRange.Reachable.Reset();
+	OutRange.CostToReach.Reset();
+	OutRange.Parents.Reset();
+	LastNodesExpanded = 0;
+	LastBufferAllocations = 0;
+	if (!GridRef) return false;
+
+	const int32 OriginIdx = GridRef->GetTileIndex(Origin);
+	if (!GridRef->HasTileAtIndex(OriginIdx))
+		return false;
+
+	const int32 Count = GridRef->GetTileIndexCount();
+	const int32 Budget = Rules.Profile.MovementBudget;
+	OutRange.OriginIndex = OriginIdx;
+	OutRange.GridVersion = GridRef->GetGridVersion();
+	OutRange.Rules = Rules;
+	OutRange.Reachable.Init(false, Count);
+
+	Cost.Init(INDEX_NONE, Count);
+	if (Rules.bKeepCosts)
+		OutRange.Parents.Init(INDEX_NONE, Count);
+	int32* Parents = Rules.bKeepCosts ? OutRange.Parents.GetData() : nullptr;
+
+	// Dijkstra borné par le budget : entrées périmées ignorées au pop, comme l'arbre de l'aperçu
+	OpenHeap.Reset();
+	Cost[OriginIdx] = 0;
+	OpenHeap.HeapPush(FOpenEntry{0, 0, OriginIdx}, FOpenLess());
+
+	GridRef->WithTileIndexer([&](const auto& Indexer)
 	{
-		if (const FHexAxialCoordinates* Prev = Parent.Find(Cur))
+		while (OpenHeap.Num() > 0)
 		{
-			Cur = *Prev;
-			OutPath.Add(Cur);
+			FOpenEntry Top;
+			OpenHeap.HeapPop(Top, FOpenLess(), EAllowShrinking::No);
+			if (Top.F != Cost[Top.Index])
+				continue;
+
+			const int32 CurIdx = Top.Index;
+			OutRange.Reachable[CurIdx] = true;
+			++LastNodesExpanded;
+
+			// Zone de contrôle : on y entre, on n'en repart pas (sauf si on y commence le tour)
+			if (CurIdx != OriginIdx && Rules.IsZoneOfControl(CurIdx))
+				continue;
+
+			GridRef->ForEachNeighborIndex(Indexer, CurIdx, [&](int32 NIdx, int32 /*Dir*/)
+			{
+				const uint8 Step = Rules.Profile.GetStepCost(GridRef->GetTileTypeAtIndex(NIdx), GridRef->GetTileMoveCostAtIndex(NIdx));
+				if (Step == 0 || Rules.IsBlocked(NIdx))
+					return; // infranchissable
+
+				const int32 NewCost = Top.F + Step;
+				if ((Budget > 0 && NewCost > Budget) || (Cost[NIdx] != INDEX_NONE && Cost[NIdx] <= NewCost))
+					return;
+				Cost[NIdx] = NewCost;
+				if (Parents)
+					Parents[NIdx] = CurIdx;
+				OpenHeap.HeapPush(FOpenEntry{NewCost, 0, NIdx}, FOpenLess());
+			});
 		}
-		else
+	});
+
+	LastBufferAllocations = HeapMark.Grew(OpenHeap) + ReachableMark.Grew(OutRange.Reachable)
+	                      + CostMark.Grew(Cost) + ParentsMark.Grew(OutRange.Parents);
+	// Chaque case atteinte est développée une fois : autant de noeuds que de cases
+	HexStats::RecordQuery({EHexQueryKind::MovementRange, LastNodesExpanded, LastNodesExpanded, false, true});
+	return true;
+}
+
+bool UHexPathFinder::ValidateMove(const FHexMovementRange& Range, TConstArrayView<FHexAxialCoordinates> Path) const
+{
+	if (!GridRef || !Range.IsValid() || Range.GridVersion != GridRef->GetGridVersion() || Path.Num() == 0)
+		return false;
+	if (GridRef->GetTileIndex(Path[0]) != Range.OriginIndex)
+		return false;
+
+	const FHexRangeRules& Rules = Range.Rules;
+	int32 Spent = 0;
+	for (int32 i = 1; i < Path.Num(); ++i)
+	{
+		const int32 Prev = GridRef->GetTileIndex(Path[i - 1]);
+		const int32 Idx = GridRef->GetTileIndex(Path[i]);
+		if (!Range.Contains(Idx) || !GridRef->AreNeighbors(Path[i - 1], Path[i]))
+			return false;
+		if (i > 1 && Rules.IsZoneOfControl(Prev))
+			return false; // le mouvement aurait dû s'arrêter sur Prev
+
+		const uint8 Step = Rules.Profile.GetStepCost(GridRef->GetTileTypeAtIndex(Idx), GridRef->GetTileMoveCostAtIndex(Idx));
+		if (Step == 0 || Rules.IsBlocked(Idx))
+			return false;
+		Spent += Step;
+	}
+	return Range.GetBudget() <= 0 || Spent <= Range.GetBudget();
+}
+
+bool UHexPathFinder::BuildFlowField(const TArray<FHexAxialCoordinates>& Targets, FHexFlowField& OutField)
+{
+	HEX_SCOPE(STAT_HexFlowField, "Hex::BuildFlowField");
+	OutField = FHexFlowField();
+	if (!GridRef) return false;
+
+	const int32 Count = GridRef->GetTileIndexCount();
+	OutField.GridVersion = GridRef->GetGridVersion();
+	OutField.Radius = GridRef->GetIndexedRadius();
+	OutField.bOffsetOnQ = GridRef->bOffsetOnQ;
+	OutField.Distances.Init(FHexFlowField::Unreached, Count);
+	OutField.Directions.Init(FHexFlowField::NoDirection, Count);
+
+	// Toutes les cibles à 0 dans le même tas : chaque case finit rattachée à la plus proche
+	OpenHeap.Reset();
+	for (const FHexAxialCoordinates& T : Targets)
+	{
+		const int32 Idx = GridRef->GetTileIndex(T);
+		if (!GridRef->HasTileAtIndex(Idx) || OutField.Distances[Idx] == 0)
+			continue;
+		OutField.Distances[Idx] = 0;
+		OutField.Targets.Add(T);
+		OpenHeap.HeapPush(FOpenEntry{0, 0, Idx}, FOpenLess());
+	}
+
+	PropagateFlowField(OutField);
+	HexStats::RecordQuery({EHexQueryKind::FlowField, 0, 0, false, OutField.Targets.Num() > 0});
+	return OutField.Targets.Num() > 0;
+}
+
+void UHexPathFinder::PropagateFlowField(FHexFlowField& Field)
+{
+	TArray<int32>& Dist = Field.Distances;
+	GridRef->WithTileIndexer([&](const auto& Indexer)
+	{
+		while (OpenHeap.Num() > 0)
 		{
-			OutPath.Reset(); // cassé
-			return;
+			FOpenEntry Top;
+			OpenHeap.HeapPop(Top, FOpenLess(), EAllowShrinking::No);
+			if (Top.F != Dist[Top.Index])
+				continue; // périmée
+
+			// Entrer dans Cur coûte son coût de terrain ; une cible infranchissable n'attire personne
+			const int32 CurIdx = Top.Index;
+			const uint8 Enter = GridRef->GetTileMoveCostAtIndex(CurIdx);
+			if (Enter == 0)
+				continue;
+
+			const int32 NewDist = Top.F + Enter;
+			GridRef->ForEachNeighborIndex(Indexer, CurIdx, [&](int32 NIdx, int32 Dir)
+			{
+				if (NewDist >= Dist[NIdx] || GridRef->GetTileMoveCostAtIndex(NIdx) == 0)
+					return;
+				Dist[NIdx] = NewDist;
+				Field.Directions[NIdx] = uint8(HexMath::OppositeDir(Dir)); // de NIdx vers Cur
+				OpenHeap.HeapPush(FOpenEntry{NewDist, 0, NIdx}, FOpenLess());
+			});
 		}
+	});
+}
+
+bool UHexPathFinder::UpdateFlowFieldTargetMoved(FHexFlowField& Field, const FHexAxialCoordinates& From, const FHexAxialCoordinates& To)
+{
+	if (!GridRef) return false;
+
+	TArray<FHexAxialCoordinates> NewTargets = Field.Targets;
+	NewTargets.Remove(From);
+	NewTargets.AddUnique(To);
+
+	const int32 FromIdx = GridRef->GetTileIndex(From);
+	const int32 ToIdx = GridRef->GetTileIndex(To);
+	const bool bStale = !Field.IsValid() || Field.GridVersion != GridRef->GetGridVersion() ||
+	                    Field.Distances.Num() != GridRef->GetTileIndexCount();
+	if (bStale || !Field.Targets.Contains(From) || !GridRef->HasTileAtIndex(ToIdx))
+		return BuildFlowField(NewTargets, Field);
+	if (From == To)
+		return true;
+
+	HEX_SCOPE(STAT_HexFlowField, "Hex::UpdateFlowField");
+	TArray<int32>& Dist = Field.Distances;
+	TArray<uint8>& Dirs = Field.Directions;
+	Field.Targets = MoveTemp(NewTargets);
+
+	// 1) Nouvelle source : ne peut que faire baisser des distances, on propage ces baisses
+	OpenHeap.Reset();
+	if (Dist[ToIdx] != 0)
+	{
+		Dist[ToIdx] = 0;
+		Dirs[ToIdx] = FHexFlowField::NoDirection;
+		OpenHeap.HeapPush(FOpenEntry{0, 0, ToIdx}, FOpenLess());
+		PropagateFlowField(Field);
 	}
-	Algo::Reverse(OutPath);
+
+	// 2) Source retirée : seul le sous-arbre encore rattaché à From est faux.
+	//    Enfant de U = voisin dont la direction pointe vers U ; Unreached sert de marque « déjà pris ».
+	FlowQueue.Reset();
+	FlowQueue.Add(FromIdx);
+	Dist[FromIdx] = FHexFlowField::Unreached;
+	Dirs[FromIdx] = FHexFlowField::NoDirection;
+	for (int32 i = 0; i < FlowQueue.Num(); ++i)
+	{
+		GridRef->ForEachNeighborIndex(FlowQueue[i], [&](int32 NIdx, int32 Dir)
+		{
+			if (Dist[NIdx] == FHexFlowField::Unreached || Dirs[NIdx] != (Dir + 3) % 6)
+				return;
+			Dist[NIdx] = FHexFlowField::Unreached;
+			Dirs[NIdx] = FHexFlowField::NoDirection;
+			FlowQueue.Add(NIdx);
+		});
+	}
+
+	// Amorce par le bord du sous-arbre (valeurs hors sous-arbre déjà exactes), puis Dijkstra
+	for (const int32 Idx : FlowQueue)
+	{
+		if (GridRef->GetTileMoveCostAtIndex(Idx) == 0)
+			continue;
+		GridRef->ForEachNeighborIndex(Idx, [&](int32 NIdx, int32 Dir)
+		{
+			const uint8 Enter = GridRef->GetTileMoveCostAtIndex(NIdx);
+			if (Dist[NIdx] == FHexFlowField::Unreached || Enter == 0 || Dist[NIdx] + Enter >= Dist[Idx])
+				return;
+			Dist[Idx] = Dist[NIdx] + Enter;
+			Dirs[Idx] = uint8(Dir);
+		});
+		if (Dist[Idx] != FHexFlowField::Unreached)
+			OpenHeap.HeapPush(FOpenEntry{Dist[Idx], 0, Idx}, FOpenLess());
+	}
+	PropagateFlowField(Field);
+	return true;
+}
+
+void UHexPathFinder::SearchSnapshot(const FHexGridSnapshot& Snap, int32 StartIdx, int32 GoalIdx,
+                                    const FHexPathCostProfile& Profile, const std::atomic<bool>& Cancelled,
+                                    FHexPathResult& Out)
+{
+	HEX_SCOPE(STAT_HexFindPathAsync, "Hex::SearchSnapshot");
+	thread_local FWorkerScratch Scratch;
+	Scratch.Begin(Snap.Num());
+	const uint32 Gen = Scratch.Generation;
+
+	// Heuristique admissible : distance * plus petit coût franchissable (un profil ne fait que l'augmenter)
+	const int32 MinCost = Profile.bIgnoreTerrain ? 1 : Snap.MinMoveCost;
+
+	const FHexAxialCoordinates Goal = Snap.TileCoords[GoalIdx];
+	auto H = [&](int32 Index) { return HexMath::Distance(Snap.TileCoords[Index].ToHexMath(), Goal.ToHexMath()) * MinCost; };
+
+	FWorkerScratch::FNode& StartNode = Scratch.Nodes[StartIdx];
+	StartNode = {0, INDEX_NONE, Gen, false};
+	Scratch.Heap.HeapPush({H(StartIdx), H(StartIdx), StartIdx}, FOpenLess());
+
+	Snap.WithTileIndexer([&](const auto& Indexer)
+	{
+		int32 Pops = 0;
+		while (Scratch.Heap.Num() > 0)
+		{
+			if ((++Pops % CancelCheckInterval) == 0 && Cancelled.load(std::memory_order_relaxed))
+				return;
+
+			FWorkerScratch::FEntry Top;
+			Scratch.Heap.HeapPop(Top, FOpenLess(), EAllowShrinking::No);
+
+			FWorkerScratch::FNode& Cur = Scratch.Nodes[Top.Index];
+			if (Cur.bClosed)
+				continue;
+			Cur.bClosed = true;
+			++Out.NodesExpanded;
+
+			if (Top.Index == GoalIdx)
+			{
+				// Tronqué à la dernière tuile payable avec le budget du tour
+				int32 Last = GoalIdx;
+				if (Profile.MovementBudget > 0)
+					while (Scratch.Nodes[Last].G > Profile.MovementBudget)
+						Last = Scratch.Nodes[Last].Parent;
+
+				int32 Len = 0;
+				for (int32 I = Last; I != INDEX_NONE; I = Scratch.Nodes[I].Parent)
+					++Len;
+
+				Out.Path.SetNumUninitialized(Len);
+				for (int32 k = Len - 1, I = Last; k >= 0; --k, I = Scratch.Nodes[I].Parent)
+					Out.Path[k] = Snap.TileCoords[I];
+				HEX_VALIDATE_PATH(Out.Path, TEXT("Async A*"), false);
+				Out.Cost = Cur.G;
+				Out.bFound = true;
+				return;
+			}
+
+			const int32 CurIdx = Top.Index;
+			const int32 CurG = Cur.G;
+			Snap.ForEachNeighborIndex(Indexer, CurIdx, [&](int32 NIdx, int32 /*Dir*/)
+			{
+				const uint8 Step = Profile.GetStepCost(Snap.TileTypes[NIdx], Snap.MoveCosts[NIdx]);
+				if (Step == 0)
+					return; // infranchissable
+
+				const int32 TentativeG = CurG + Step;
+				FWorkerScratch::FNode& N = Scratch.Nodes[NIdx];
+				if (N.Generation != Gen)
+				{
+					N.Generation = Gen;
+					N.bClosed = false;
+				}
+				else if (N.bClosed || TentativeG >= N.G)
+				{
+					return;
+				}
+
+				N.G = TentativeG;
+				N.Parent = CurIdx;
+				const int32 NH = H(NIdx);
+				Scratch.Heap.HeapPush({TentativeG + NH, NH, NIdx}, FOpenLess());
+			});
+		}
+	});
+	HexStats::RecordQuery({EHexQueryKind::FindPathAsync, Out.NodesExpanded, Out.Path.Num(), false, Out.bFound});
+}
+
+bool UHexPathFinder::SyncPathCache()
+{
+	if (!GridRef || PathCacheCapacity <= 0)
+	{
+		if (PathCacheSlots.Num() > 0)
+		{
+			PathCacheSlots.Empty();
+			PathCacheIndex.Empty();
+			PathCacheNewest = PathCacheOldest = INDEX_NONE;
+		}
+		return false;
+	}
+
+	// Une seule version par cache : pas d'entrée périmée à chercher ni à expulser
+	const uint32 Version = GridRef->GetGridVersion();
+	if (PathCacheSlots.Num() != PathCacheCapacity)
+	{
+		// Seul cas où le cache (ré)alloue : emplacements et index dimensionnés une fois pour toutes
+		PathCacheSlots.Empty(PathCacheCapacity);
+		PathCacheSlots.SetNum(PathCacheCapacity);
+		PathCacheIndex.Empty(PathCacheCapacity);
+		PathCacheNewest = PathCacheOldest = INDEX_NONE;
+		CacheGridVersion = Version;
+	}
+	else if (Version != CacheGridVersion)
+	{
+		ClearPathCache();
+		CacheGridVersion = Version;
+	}
+	return true;
+}
+
+void UHexPathFinder::ClearPathCache()
+{
+	PathCacheIndex.Reset();
+	PathCacheNewest = PathCacheOldest = INDEX_NONE;
+}
+
+void UHexPathFinder::UnlinkCachedPath(int32 Slot)
+{
+	FCachedPath& Entry = PathCacheSlots[Slot];
+	(Entry.Newer != INDEX_NONE ? PathCacheSlots[Entry.Newer].Older : PathCacheNewest) = Entry.Older;
+	(Entry.Older != INDEX_NONE ? PathCacheSlots[Entry.Older].Newer : PathCacheOldest) = Entry.Newer;
+	Entry.Newer = Entry.Older = INDEX_NONE;
+}
+
+void UHexPathFinder::LinkCachedPathAsNewest(int32 Slot)
+{
+	FCachedPath& Entry = PathCacheSlots[Slot];
+	Entry.Newer = INDEX_NONE;
+	Entry.Older = PathCacheNewest;
+	(PathCacheNewest != INDEX_NONE ? PathCacheSlots[PathCacheNewest].Newer : PathCacheOldest) = Slot;
+	PathCacheNewest = Slot;
+}
+
+const UHexPathFinder::FCachedPath* UHexPathFinder::FindCachedPath(const FPathCacheKey& Key)
+{
+	const int32* Slot = PathCacheIndex.Find(Key);
+	++(Slot ? PathCacheHits : PathCacheMisses);
+	if (!Slot)
+		return nullptr;
+	if (*Slot != PathCacheNewest)
+	{
+		UnlinkCachedPath(*Slot);
+		LinkCachedPathAsNewest(*Slot);
+	}
+	return &PathCacheSlots[*Slot];
+}
+
+int32 UHexPathFinder::AddCachedPath(const FPathCacheKey& Key, bool bFound, int32 Cost, TConstArrayView<FHexAxialCoordinates> Path)
+{
+	// Clé déjà présente (requête asynchrone doublée par un FindPath), sinon emplacement libre, sinon le plus ancien
+	int32 Slot;
+	if (const int32* Existing = PathCacheIndex.Find(Key))
+	{
+		Slot = *Existing;
+		UnlinkCachedPath(Slot);
+	}
+	else if (PathCacheIndex.Num() < PathCacheSlots.Num())
+	{
+		// Les emplacements se remplissent dans l'ordre depuis le dernier vidage : le suivant est libre
+		Slot = PathCacheIndex.Num();
+		PathCacheIndex.Add(Key, Slot);
+	}
+	else
+	{
+		Slot = PathCacheOldest;
+		UnlinkCachedPath(Slot);
+		PathCacheIndex.Remove(PathCacheSlots[Slot].Key);
+		PathCacheIndex.Add(Key, Slot);
+	}
+
+	FCachedPath& Entry = PathCacheSlots[Slot];
+	const FBufferMark PathMark(Entry.Path);
+	Entry.Key = Key;
+	Entry.bFound = bFound;
+	Entry.Cost = Cost;
+	Entry.Path.Reset();
+	Entry.Path.Append(Path.GetData(), Path.Num());
+	LinkCachedPathAsNewest(Slot);
+	return PathMark.Grew(Entry.Path);
+}
+
+void UHexPathFinder::GetPathCacheStats(int32& OutHits, int32& OutMisses, int32& OutEntries) const
+{
+	OutHits = PathCacheHits;
+	OutMisses = PathCacheMisses;
+	OutEntries = PathCacheIndex.Num();
+}
+
+void UHexPathFinder::ResetPathCache()
+{
+	ClearPathCache();
+	PathCacheHits = 0;
+	PathCacheMisses = 0;
+}
+
+FHexPathRequestHandle UHexPathFinder::RequestPathAsync(const FHexAxialCoordinates& Start,
+                                                       const FHexAxialCoordinates& Goal,
+                                                       const FHexPathCostProfile& Profile,
+                                                       FOnHexPathResult OnResult,
+                                                       FName Channel)
+{
+	check(IsInGameThread());
+
+	FHexPathRequestHandle Handle;
+	Handle.Id = BeginRequest(Channel);
+
+	FHexPathResult Result;
+	Result.RequestId = Handle.Id;
+
+	// Réponse immédiate, toujours via le rappel (jamais en ligne)
+	auto ReplyNextTick = [this, &Handle, &Channel, &OnResult](FHexPathResult&& Ready)
+	{
+		PendingRequests.Add(Handle.Id, FPendingRequest{MakeShared<std::atomic<bool>, ESPMode::ThreadSafe>(false), Channel});
+		AsyncTask(ENamedThreads::GameThread, [WeakThis = TWeakObjectPtr<UHexPathFinder>(this), Ready = MoveTemp(Ready), OnResult = MoveTemp(OnResult)]() mutable
+		{
+			if (UHexPathFinder* Self = WeakThis.Get())
+				Self->CompleteRequest(MoveTemp(Ready), MoveTemp(OnResult));
+		});
+	};
+
+	const int32 StartIdx = GridRef ? GridRef->GetTileIndex(Start) : INDEX_NONE;
+	const int32 GoalIdx  = GridRef ? GridRef->GetTileIndex(Goal) : INDEX_NONE;
+	if (!GridRef || !GridRef->HasTileAtIndex(StartIdx) || !GridRef->HasTileAtIndex(GoalIdx))
+	{
+		// Rien à chercher
+		Result.GridVersion = GridRef ? GridRef->GetGridVersion() : 0;
+		ReplyNextTick(MoveTemp(Result));
+		return Handle;
+	}
+
+	// Profil sans restriction : même résultat que FindPath avec ce budget, le cache est partagé
+	FPathCacheKey CacheKey;
+	if (Profile.UsesGridCostsOnly() && SyncPathCache())
+	{
+		CacheKey = FPathCacheKey{StartIdx, GoalIdx, Profile.MovementBudget};
+		if (const FCachedPath* Hit = FindCachedPath(CacheKey))
+		{
+			Result.GridVersion = CacheGridVersion;
+			Result.bFound = Hit->bFound;
+			Result.Cost = Hit->Cost;
+			Result.Path = Hit->Path;
+			HexStats::RecordQuery({EHexQueryKind::FindPathAsync, 0, Result.Path.Num(), true, Result.bFound});
+			ReplyNextTick(MoveTemp(Result));
+			return Handle;
+		}
+	}
+
+	FCancelFlag Cancelled = MakeShared<std::atomic<bool>, ESPMode::ThreadSafe>(false);
+	PendingRequests.Add(Handle.Id, FPendingRequest{Cancelled, Channel, CacheKey});
+
+	TSharedRef<const FHexGridSnapshot, ESPMode::ThreadSafe> Snap = GridRef->GetSnapshot();
+	Result.GridVersion = Snap->Version;
+
+	UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[WeakThis = TWeakObjectPtr<UHexPathFinder>(this), Snap, StartIdx, GoalIdx, Profile, Cancelled,
+		 Result = MoveTemp(Result), OnResult = MoveTemp(OnResult)]() mutable
+		{
+			if (!Cancelled->load(std::memory_order_relaxed))
+				SearchSnapshot(*Snap, StartIdx, GoalIdx, Profile, *Cancelled, Result);
+
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, Result = MoveTemp(Result), OnResult = MoveTemp(OnResult)]() mutable
+			{
+				if (UHexPathFinder* Self = WeakThis.Get())
+					Self->CompleteRequest(MoveTemp(Result), MoveTemp(OnResult));
+			});
+		});
+
+	return Handle;
+}
+
+uint32 UHexPathFinder::BeginRequest(FName Channel)
+{
+	// Une requête plus récente sur le même canal rend la précédente inutile
+	if (!Channel.IsNone())
+	{
+		for (auto It = PendingRequests.CreateIterator(); It; ++It)
+		{
+			if (It.Value().Channel == Channel)
+			{
+				It.Value().Cancelled->store(true, std::memory_order_relaxed);
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	uint32 Id = ++NextRequestId;
+	if (Id == 0)
+		Id = ++NextRequestId;
+	return Id;
+}
+
+bool UHexPathFinder::TakePendingRequest(uint32 RequestId, FPathCacheKey* OutCacheKey)
+{
+	// Annulée ou remplacée : plus dans la table, on jette le résultat
+	const FPendingRequest* Pending = PendingRequests.Find(RequestId);
+	if (!Pending)
+		return false;
+	const bool bCancelled = Pending->Cancelled->load();
+	if (OutCacheKey)
+		*OutCacheKey = Pending->CacheKey;
+	PendingRequests.Remove(RequestId);
+	return !bCancelled;
+}
+
+FHexPathRequestHandle UHexPathFinder::RequestCooperativePlanAsync(const TArray<FHexAgentMoveRequest>& Agents,
+                                                                  FOnHexCooperativePlan OnResult,
+                                                                  int32 Window,
+                                                                  FName Channel)
+{
+	check(IsInGameThread());
+
+	FHexPathRequestHandle Handle;
+	Handle.Id = BeginRequest(Channel);
+
+	FCancelFlag Cancelled = MakeShared<std::atomic<bool>, ESPMode::ThreadSafe>(false);
+	PendingRequests.Add(Handle.Id, FPendingRequest{Cancelled, Channel});
+
+	FHexCooperativePlan Plan;
+	Plan.RequestId = Handle.Id;
+	if (!GridRef)
+	{
+		AsyncTask(ENamedThreads::GameThread, [WeakThis = TWeakObjectPtr<UHexPathFinder>(this), Plan = MoveTemp(Plan), OnResult = MoveTemp(OnResult)]() mutable
+		{
+			if (UHexPathFinder* Self = WeakThis.Get())
+				Self->CompleteCooperativePlan(MoveTemp(Plan), MoveTemp(OnResult));
+		});
+		return Handle;
+	}
+
+	TSharedRef<const FHexGridSnapshot, ESPMode::ThreadSafe> Snap = GridRef->GetSnapshot();
+	Plan.GridVersion = Snap->Version;
+
+	UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[WeakThis = TWeakObjectPtr<UHexPathFinder>(this), Snap, Agents, Window, Budget = MovementBudget, Cancelled,
+		 Plan = MoveTemp(Plan), OnResult = MoveTemp(OnResult)]() mutable
+		{
+			if (!Cancelled->load(std::memory_order_relaxed))
+			{
+				HEX_SCOPE(STAT_HexCooperativePlan, "Hex::CooperativePlan");
+				FHexCooperativePlanner::Plan(*Snap, Agents, Window, Budget, *Cancelled, Plan);
+				int32 PlannedSteps = 0;
+				for (const TArray<FHexAxialCoordinates>& AgentPath : Plan.Paths)
+					PlannedSteps += AgentPath.Num();
+				HexStats::RecordQuery({EHexQueryKind::Cooperative, Plan.NodesExpanded, PlannedSteps, false, !Cancelled->load(std::memory_order_relaxed)});
+			}
+
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, Plan = MoveTemp(Plan), OnResult = MoveTemp(OnResult)]() mutable
+			{
+				if (UHexPathFinder* Self = WeakThis.Get())
+					Self->CompleteCooperativePlan(MoveTemp(Plan), MoveTemp(OnResult));
+			});
+		});
+
+	return Handle;
+}
+
+void UHexPathFinder::CompleteCooperativePlan(FHexCooperativePlan&& Plan, FOnHexCooperativePlan&& OnResult)
+{
+	if (!TakePendingRequest(Plan.RequestId))
+		return;
+
+	// Plans espace-temps : une case répétée est une attente
+	for (const TArray<FHexAxialCoordinates>& Path : Plan.Paths)
+		HEX_VALIDATE_PATH(Path, TEXT("WHCA*"), true);
+	OnResult.ExecuteIfBound(Plan);
+}
+
+void UHexPathFinder::CompleteRequest(FHexPathResult&& Result, FOnHexPathResult&& OnResult)
+{
+	FPathCacheKey CacheKey;
+	if (!TakePendingRequest(Result.RequestId, &CacheKey))
+		return;
+
+	// Recherche menée sur la version courante : réutilisable tant que la grille ne bouge pas
+	if (CacheKey.Start != INDEX_NONE && SyncPathCache() && Result.GridVersion == CacheGridVersion)
+		AddCachedPath(CacheKey, Result.bFound, Result.Cost, Result.Path);
+
+	OnResult.ExecuteIfBound(Result);
+}
+
+void UHexPathFinder::CancelPathRequest(FHexPathRequestHandle Handle)
+{
+	if (const FPendingRequest* Pending = Handle.IsValid() ? PendingRequests.Find(Handle.Id) : nullptr)
+	{
+		Pending->Cancelled->store(true, std::memory_order_relaxed);
+		PendingRequests.Remove(Handle.Id);
+	}
+}
+
+void UHexPathFinder::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	for (auto& Pair : PendingRequests)
+		Pair.Value.Cancelled->store(true, std::memory_order_relaxed);
+	PendingRequests.Reset();
+
+	if (GridRef && GridChangedHandle.IsValid())
+		GridRef->OnGridChanged.Remove(GridChangedHandle);
+	GridChangedHandle.Reset();
+
+	Super::EndPlay(EndPlayReason);
 }
 
 TArray<FHexAxialCoordinates> UHexPathFinder::FindPath(const FHexAxialCoordinates& Start,
                                                       const FHexAxialCoordinates& Goal)
 {
-    TArray<FHexAxialCoordinates> Empty;
-    if (!GridRef) return Empty;
-
-    if (Start == Goal)
-    {
-        TArray<FHexAxialCoordinates> P; P.Add(Start);
-        return P;
-    }
-
-    TSet<FHexAxialCoordinates> Open, Closed;
-    TMap<FHexAxialCoordinates, FHexAxialCoordinates> Parent;
-    TMap<FHexAxialCoordinates, int32> GScore, FScore;
-
-    Open.Add(Start);
-    Parent.Add(Start, Start);
-    GScore.Add(Start, 0);
-    FScore.Add(Start, Heuristic(Start, Goal));
-
-    while (Open.Num() > 0)
-    {
-        // Choisir le noeud avec F-score min
-        FHexAxialCoordinates Current = *Open.CreateConstIterator();
-        int32 BestF = FScore.FindRef(Current);
-        for (const FHexAxialCoordinates& N : Open)
-        {
-            const int32 FN = FScore.FindRef(N);
-            if (FN < BestF)
-            {
-                BestF = FN;
-                Current = N;
-            }
-        }
-
-        if (Current == Goal)
-        {
-            TArray<FHexAxialCoordinates> OutPath;
-            ReconstructPath(Parent, Start, Goal, OutPath);
-
-            // Limite de déplacement par tour: 6 pas (donc 7 nœuds Start+6)
-            if (OutPath.Num() > 0)
-            {
-                const int32 MaxStepsPerTurn = 6; // arbitraire pour l’instant
-                const int32 MaxLen = FMath::Max(1, MaxStepsPerTurn + 1); // +1 pour inclure Start
-                if (OutPath.Num() > MaxLen)
-                {
-                    OutPath.SetNum(MaxLen, EAllowShrinking::No);
-                }
-            }
-            return OutPath;
-        }
-
-        Open.Remove(Current);
-        Closed.Add(Current);
-
-        // Voisins valides
-        TArray<FHexAxialCoordinates> Neighbors;
-        GetValidNeighbors(Current, Neighbors);
-
-        const int32 GCur = GScore.FindRef(Current);
-        for (const FHexAxialCoordinates& N : Neighbors)
-        {
-            if (Closed.Contains(N)) continue;
-
-            const int32 TentativeG = GCur + 1;
-            bool bBetter = false;
-
-            if (!Open.Contains(N))
-            {
-                Open.Add(N);
-                bBetter = true;
-            }
-            else if (TentativeG < GScore.FindRef(N))
-            {
-                bBetter = true;
-            }
-
-            if (bBetter)
-            {
-                Parent.Add(N, Current);
-                GScore.Add(N, TentativeG);
-                FScore.Add(N, TentativeG + Heuristic(N, Goal));
-            }
-        }
-    }
-
-    return Empty;
-}
\ No newline at end of file
+	TArray<FHexAxialCoordinates> OutPath;
+	FindPathInto(Start, Goal, OutPath);
+	return OutPath;
+}
+
+bool UHexPathFinder::FindPathInto(const FHexAxialCoordinates& Start,
+                                  const FHexAxialCoordinates& Goal,
+                                  TArray<FHexAxialCoordinates>& OutPath)
+{
+	HEX_SCOPE(STAT_HexFindPath, "Hex::FindPath");
+	OutPath.Reset();
+	const FBufferMark NodesMark(Nodes), HeapMark(OpenHeap), PathMark(OutPath);
+	LastNodesExpanded = 0;
+	LastBufferAllocations = 0;
+	if (!GridRef) return false;
+
+	if (Start == Goal)
+	{
+		OutPath.Add(Start);
+		return true;
+	}
+
+	const int32 StartIdx = GridRef->GetTileIndex(Start);
+	const int32 GoalIdx  = GridRef->GetTileIndex(Goal);
+	if (!GridRef->HasTileAtIndex(StartIdx) || !GridRef->HasTileAtIndex(GoalIdx))
+		return false;
+
+	const FPathCacheKey CacheKey{StartIdx, GoalIdx, MovementBudget};
+	const bool bUseCache = SyncPathCache();
+	if (bUseCache)
+	{
+		if (const FCachedPath* Hit = FindCachedPath(CacheKey))
+		{
+			OutPath.Append(Hit->Path);
+			LastBufferAllocations = PathMark.Grew(OutPath);
+			HexStats::RecordQuery({EHexQueryKind::FindPath, 0, OutPath.Num(), true, Hit->bFound});
+			return Hit->bFound;
+		}
+	}
+
+	BeginSearch(GridRef->GetTileIndexCount());
+	const uint32 Gen = SearchGeneration;
+
+	FNodeRecord& StartNode = Nodes[StartIdx];
+	StartNode.Generation = Gen;
+	StartNode.G = 0;
+	StartNode.Parent = INDEX_NONE;
+	StartNode.bClosed = false;
+
+	const int32 StartH = Heuristic(Start, Goal);
+	OpenHeap.HeapPush(FOpenEntry{StartH, StartH, StartIdx}, FOpenLess());
+
+	int32 FoundCost = INDEX_NONE;
+	GridRef->WithTileIndexer([&](const auto& Indexer)
+	{
+		while (OpenHeap.Num() > 0)
+		{
+			FOpenEntry Top;
+			OpenHeap.HeapPop(Top, FOpenLess(), EAllowShrinking::No);
+
+			FNodeRecord& CurNode = Nodes[Top.Index];
+			if (CurNode.bClosed)
+				continue; // entrée périmée (déjà développée avec un meilleur G)
+			CurNode.bClosed = true;
+			++LastNodesExpanded;
+
+			if (Top.Index == GoalIdx)
+			{
+				FoundCost = CurNode.G;
+				return;
+			}
+
+			const int32 CurIdx = Top.Index;
+			const int32 CurG = CurNode.G;
+
+			GridRef->ForEachNeighborIndex(Indexer, CurIdx, [&](int32 NIdx, int32 /*Dir*/)
+			{
+				const uint8 Step = GridRef->GetTileMoveCostAtIndex(NIdx);
+				if (Step == 0)
+					return; // infranchissable
+
+				const int32 TentativeG = CurG + Step;
+				FNodeRecord& NNode = Nodes[NIdx];
+				if (NNode.Generation != Gen)
+				{
+					NNode.Generation = Gen;
+					NNode.bClosed = false;
+				}
+				else if (NNode.bClosed || TentativeG >= NNode.G)
+				{
+					return;
+				}
+
+				NNode.G = TentativeG;
+				NNode.Parent = CurIdx;
+
+				const int32 H = Heuristic(GridRef->GetTileCoords(NIdx), Goal);
+				OpenHeap.HeapPush(FOpenEntry{TentativeG + H, H, NIdx}, FOpenLess());
+			});
+		}
+	});
+
+	const bool bFound = FoundCost != INDEX_NONE;
+	if (bFound)
+		ReconstructPath(GoalIdx, MovementBudget, OutPath);
+	LastBufferAllocations = NodesMark.Grew(Nodes) + HeapMark.Grew(OpenHeap) + PathMark.Grew(OutPath);
+	if (bUseCache)
+		LastBufferAllocations += AddCachedPath(CacheKey, bFound, bFound ? FoundCost : 0, OutPath);
+	HexStats::RecordQuery({EHexQueryKind::FindPath, LastNodesExpanded, OutPath.Num(), false, bFound});
+	return bFound;
+}
@@ -0,0 +1,219 @@
+// HexPathfindingTests.cpp
+//
+// Test d'automation Hex.Pathfinding : A*, portée, validation serveur et réparation D* Lite sur grilles synthétiques,
+// puis banc réduit.
+// En headless :
+//   UnrealEditor-Cmd <Projet>.uproject -game -nullrhi -unattended -nosplash -ExecCmds="Automation RunTests Hex, Quit"
+
+#include "HexBenchmark.h"
+#include "HexDStarLite.h"
+#include "HexGridManager.h"
+#include "HexPathFinder.h"
+#include "HexMovementRange.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && !UE_BUILD_SHIPPING
+
+namespace
+{
+	/** Coût d'entrée cumulé (origine exclue) ; INDEX_NONE si un pas n'est pas adjacent ou infranchissable */
+	int32 WalkPath(const UHexGridManager& Grid, TConstArrayView<FHexAxialCoordinates> Path)
+	{
+		int32 Cost = 0;
+		for (int32 i = 1; i < Path.Num(); ++i)
+		{
+			const int32 Idx = Grid.GetTileIndex(Path[i]);
+			if (!Grid.AreNeighbors(Path[i - 1], Path[i]) || !Grid.HasTileAtIndex(Idx) || Grid.GetTileMoveCostAtIndex(Idx) == 0)
+				return INDEX_NONE;
+			Cost += Grid.GetTileMoveCostAtIndex(Idx);
+		}
+		return Cost;
+	}
+
+	/** Plus petit coût praticable par balayage complet (référence de GetMinMoveCost) */
+	int32 ScanMinMoveCost(const UHexGridManager& Grid)
+	{
+		int32 Min = MAX_int32;
+		for (int32 Index = 0; Index < Grid.GetTileIndexCount(); ++Index)
+			if (Grid.HasTileAtIndex(Index) && Grid.GetTileMoveCostAtIndex(Index) > 0)
+				Min = FMath::Min(Min, int32(Grid.GetTileMoveCostAtIndex(Index)));
+		return Min == MAX_int32 ? 1 : Min;
+	}
+
+	struct FSyntheticCase
+	{
+		int32 Radius;
+		int32 Seed;
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHexPathfindingTest, "Hex.Pathfinding",
+                                 EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FHexPathfindingTest::RunTest(const FString& Parameters)
+{
+	TStrongObjectPtr<UHexGridManager> Grid(NewObject<UHexGridManager>(GetTransientPackage()));
+	TStrongObjectPtr<UHexPathFinder> PathFinder(NewObject<UHexPathFinder>(GetTransientPackage()));
+	PathFinder->Init(Grid.Get());
+
+	constexpr int32 Budget = 8;
+	constexpr int32 PairsPerGrid = 64;
+	const FSyntheticCase Cases[] = {{8, 1}, {20, 7}, {40, 42}};
+
+	TArray<FHexAxialCoordinates> Path, CachedPath, RangePath;
+	for (const FSyntheticCase& Case : Cases)
+	{
+		Grid->BuildSyntheticGrid(Case.Radius, 0.1f, 0.2f, Case.Seed);
+
+		// Même Seed, même grille
+		TArray<uint8> Costs;
+		for (int32 Index = 0; Index < Grid->GetTileIndexCount(); ++Index)
+			Costs.Add(Grid->HasTileAtIndex(Index) ? Grid->GetTileMoveCostAtIndex(Index) : 0xFF);
+		Grid->BuildSyntheticGrid(Case.Radius, 0.1f, 0.2f, Case.Seed);
+		bool bSameGrid = true;
+		for (int32 Index = 0; Index < Grid->GetTileIndexCount(); ++Index)
+			bSameGrid &= Costs[Index] == (Grid->HasTileAtIndex(Index) ? Grid->GetTileMoveCostAtIndex(Index) : 0xFF);
+		TestTrue(FString::Printf(TEXT("R=%d: synthetic grid is deterministic"), Case.Radius), bSameGrid);
+
+		TArray<FHexAxialCoordinates> Walkable;
+		for (int32 Index = 0; Index < Grid->GetTileIndexCount(); ++Index)
+			if (Grid->HasTileAtIndex(Index) && Grid->GetTileMoveCostAtIndex(Index) > 0)
+				Walkable.Add(Grid->GetTileCoords(Index));
+		if (!TestTrue(FString::Printf(TEXT("R=%d: grid has walkable tiles"), Case.Radius), Walkable.Num() >= 2))
+			continue;
+
+		PathFinder->PathCacheCapacity = 256;
+		PathFinder->ResetPathCache();
+
+		FRandomStream Rng(Case.Seed);
+		FHexMovementRange FullRange, BudgetRange;
+		FHexRangeRules FullRules, BudgetRules;
+		FullRules.Profile.MovementBudget = 0;
+		BudgetRules.Profile.MovementBudget = Budget;
+
+		for (int32 Pair = 0; Pair < PairsPerGrid; ++Pair)
+		{
+			const FHexAxialCoordinates Start = Walkable[Rng.RandHelper(Walkable.Num())];
+			const FHexAxialCoordinates Goal = Walkable[Rng.RandHelper(Walkable.Num())];
+			const int32 GoalIdx = Grid->GetTileIndex(Goal);
+			const FString What = FString::Printf(TEXT("R=%d (%d,%d)->(%d,%d)"), Case.Radius, Start.Q, Start.R, Goal.Q, Goal.R);
+
+			// --- A* complet contre Dijkstra sans budget ---
+			PathFinder->ComputeMovementRange(Start, FullRules, FullRange);
+			PathFinder->MovementBudget = 0;
+			const bool bFound = PathFinder->FindPathInto(Start, Goal, Path);
+			TestEqual(What + TEXT(": FindPath and range agree on reachability"), bFound, FullRange.Contains(GoalIdx));
+			if (bFound)
+			{
+				TestTrue(What + TEXT(": path starts at Start"), Path.Num() > 0 && Path[0] == Start);
+				TestTrue(What + TEXT(": path ends at Goal"), Path.Num() > 0 && Path.Last() == Goal);
+				TestEqual(What + TEXT(": FindPath cost == range cost"), WalkPath(*Grid, Path), FullRange.GetCost(GoalIdx));
+			}
+
+			// Servi par le cache : même chemin
+			PathFinder->FindPathInto(Start, Goal, CachedPath);
+			TestTrue(What + TEXT(": cached path is identical"), CachedPath == Path);
+
+			// --- Budget : chemin tronqué, adjacent et payable ---
+			PathFinder->MovementBudget = Budget;
+			if (PathFinder->FindPathInto(Start, Goal, Path))
+			{
+				const int32 Spent = WalkPath(*Grid, Path);
+				TestTrue(What + TEXT(": budgeted path is adjacent"), Spent != INDEX_NONE);
+				TestTrue(What + TEXT(": budgeted path is within budget"), Spent <= Budget);
+			}
+
+			// --- Portée : chaque case atteinte est payable et son chemin passe ValidateMove ---
+			PathFinder->ComputeMovementRange(Start, BudgetRules, BudgetRange);
+			bool bRangeValid = true;
+			for (TConstSetBitIterator<> It(BudgetRange.Reachable); It; ++It)
+			{
+				const int32 Cost = BudgetRange.GetCost(It.GetIndex());
+				bRangeValid &= Cost >= 0 && Cost <= Budget && Cost == FullRange.GetCost(It.GetIndex())
+				            && BudgetRange.GetPathTo(*Grid, It.GetIndex(), RangePath)
+				            && WalkPath(*Grid, RangePath) == Cost
+				            && PathFinder->ValidateMove(BudgetRange, RangePath);
+			}
+			TestTrue(What + TEXT(": range paths are shortest, within budget and validated"), bRangeValid);
+
+			// --- ValidateMove rejette un saut et un dépassement de budget ---
+			if (FullRange.Contains(GoalIdx) && !Grid->AreNeighbors(Start, Goal) && Start != Goal)
+			{
+				const FHexAxialCoordinates Jump[] = {Start, Goal};
+				TestFalse(What + TEXT(": non-adjacent step is rejected"), PathFinder->ValidateMove(FullRange, MakeArrayView(Jump)));
+			}
+			if (FullRange.GetCost(GoalIdx) > Budget)
+			{
+				FullRange.GetPathTo(*Grid, GoalIdx, RangePath);
+				TestFalse(What + TEXT(": over-budget path is rejected"), PathFinder->ValidateMove(BudgetRange, RangePath));
+			}
+		}
+
+		// --- D* Lite contre Dijkstra : à l'initialisation, puis après un pas et des changements de coûts ---
+		for (int32 Pair = 0; Pair < PairsPerGrid / 8; ++Pair)
+		{
+			const FHexAxialCoordinates Start = Walkable[Rng.RandHelper(Walkable.Num())];
+			const FHexAxialCoordinates Goal = Walkable[Rng.RandHelper(Walkable.Num())];
+			const int32 GoalIdx = Grid->GetTileIndex(Goal);
+			const FString What = FString::Printf(TEXT("R=%d D* (%d,%d)->(%d,%d)"), Case.Radius, Start.Q, Start.R, Goal.Q, Goal.R);
+
+			PathFinder->ComputeMovementRange(Start, FullRules, FullRange);
+			FHexDStarLite Replanner;
+			if (!TestTrue(What + TEXT(": initializes"), Replanner.Initialize(*Grid, Start, Goal)))
+				continue;
+			const bool bReachable = Replanner.ExtractPath(*Grid, 0, Path);
+			TestEqual(What + TEXT(": agrees with Dijkstra on reachability"), bReachable, FullRange.Contains(GoalIdx));
+			if (!bReachable || Path.Num() < 3)
+				continue;
+			TestEqual(What + TEXT(": initial cost == Dijkstra cost"), WalkPath(*Grid, Path), FullRange.GetCost(GoalIdx));
+
+			// Un pas, puis la case suivante bloquée et une case au hasard renchérie
+			const FHexAxialCoordinates NewStart = Path[1];
+			const FHexAxialCoordinates Blocked = Path[2];
+			const FHexAxialCoordinates Pricier = Walkable[Rng.RandHelper(Walkable.Num())];
+			const int32 BlockedCost = Grid->GetTileMoveCost(Blocked), PricierCost = Grid->GetTileMoveCost(Pricier);
+			if (Blocked != Goal)
+				Grid->SetTileMoveCost(Blocked, 0);
+			if (Pricier != NewStart && Pricier != Goal)
+				Grid->SetTileMoveCost(Pricier, PricierCost + 3);
+			TestEqual(What + TEXT(": incremental MinMoveCost == full scan"), Grid->GetMinMoveCost(), ScanMinMoveCost(*Grid));
+
+			TestTrue(What + TEXT(": moves start"), Replanner.MoveStart(*Grid, NewStart));
+			TestTrue(What + TEXT(": repairs"), Replanner.SyncWithGrid(*Grid));
+			PathFinder->ComputeMovementRange(NewStart, FullRules, FullRange);
+			const bool bRepaired = Replanner.ExtractPath(*Grid, 0, Path);
+			TestEqual(What + TEXT(": repaired reachability == Dijkstra"), bRepaired, FullRange.Contains(GoalIdx));
+			if (bRepaired)
+				TestEqual(What + TEXT(": repaired cost == Dijkstra cost"), WalkPath(*Grid, Path), FullRange.GetCost(GoalIdx));
+
+			Grid->SetTileMoveCost(Pricier, PricierCost);
+			Grid->SetTileMoveCost(Blocked, BlockedCost);
+			TestEqual(What + TEXT(": MinMoveCost restored"), Grid->GetMinMoveCost(), ScanMinMoveCost(*Grid));
+		}
+	}
+	PathFinder->Init(nullptr);
+
+	// --- Banc réduit : résultats dans le rapport, régime établi sans allocation ---
+	FHexBenchSettings Settings;
+	Settings.Radii = {10, 25, 50};
+	Settings.Queries = 600; // au-delà des 256 entrées du cache par défaut : la charge Cached expulse
+	Settings.bWriteCsv = false;
+	TArray<FHexBenchRow> Rows;
+	HexBench::Run(Settings, Rows);
+	TestEqual(TEXT("Bench ran every workload on every radius"), Rows.Num(), 4 * Settings.Radii.Num());
+	for (const FHexBenchRow& Row : Rows)
+	{
+		AddInfo(HexBench::FormatRow(Row));
+		const FString What = FString::Printf(TEXT("Bench R=%d %s"), Row.Radius, Row.Workload);
+		TestTrue(What + TEXT(": some queries succeed"), Row.Found > 0);
+		TestTrue(What + TEXT(": steady state does not allocate per query"), Row.AllocsPerQuery < 1.0);
+		if (FCString::Strcmp(Row.Workload, TEXT("Validate")) == 0)
+			TestEqual(What + TEXT(": every range path validates"), Row.Found, Row.Queries);
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS && !UE_BUILD_SHIPPING
@@ -1,5 +1,6 @@
 // HexPawn.cpp
 #include "HexPawn.h"
+#include "Demo.h"
 
 #include "Camera/CameraComponent.h"
 #include "Components/SceneComponent.h"
@@ -11,6 +12,9 @@
 
 #include "HexAnimationTypes.h"
 #include "HexGridManager.h"
+#include "HexDStarLite.h"
+#include "HexMovementRange.h"
+#include "HexPathFinder.h"
 #include "HexSpriteComponent.h"
 #include "HexTile.h"
 #include "CombatComponent.h"
@@ -76,7 +80,7 @@ void AHexPawn::BeginPlay()
         }
         else
         {
-            UE_LOG(LogTemp, Error, TEXT("[Sprite] Missing UHexSpriteComponent on instance"));
+            UE_LOG(LogHexAnim, Error, TEXT("[Sprite] Missing UHexSpriteComponent on instance"));
         }
     }
 
@@ -128,7 +132,7 @@ void AHexPawn::StartPathFollowing(const TArray<FHexAxialCoordinates> &InPath, UH
     CurrentPath = InPath;
 
     int32 StartIndex = 0;
-    if (CurrentTile && CurrentPath.Num() > 0 && CurrentPath[0] == CurrentTile->GetAxialCoordinates())
+    if (bHasCurrentCoords && CurrentPath.Num() > 0 && CurrentPath[0] == CurrentCoords)
     {
         StartIndex = 1;
     }
@@ -143,8 +147,8 @@ void AHexPawn::StartPathFollowing(const TArray<FHexAxialCoordinates> &InPath, UH
 
     CurrentStepIndex = StartIndex;
 
-    AHexTile *NextTile = GridRef->GetHexTileAt(CurrentPath[CurrentStepIndex]);
-    if (!NextTile)
+    FVector NextLocation;
+    if (!GridRef->GetTileWorldLocation(CurrentPath[CurrentStepIndex], NextLocation))
     {
         bIsMoving = false;
         if (HasAuthority() && SpriteComp)
@@ -153,26 +157,135 @@ void AHexPawn::StartPathFollowing(const TArray<FHexAxialCoordinates> &InPath, UH
     }
 
     StartLocation = GetActorLocation();
-    TargetLocation = NextTile->GetActorLocation();
+    TargetLocation = NextLocation;
     StepElapsed = 0.f;
     bIsMoving = true;
 
+    // Most moves never see a grid change: the replanner is only seeded by the first repair
+    PathGridVersion = GridRef->GetGridVersion();
+    PathBudgetLeft = ComputeRemainingPathCost();
+    PathGoal = CurrentPath.Last();
+    bReplannerSeeded = false;
+    RecordPathStepCosts();
+
     UpdateSpriteMirrorToward(StartLocation, TargetLocation);
     if (HasAuthority() && SpriteComp)
         SpriteComp->SetAnimationState(EHexAnimState::Walking);
 }
 
+int32 AHexPawn::ComputeRemainingPathCost() const
+{
+    int32 Cost = 0;
+    for (int32 i = CurrentStepIndex; i < CurrentPath.Num(); ++i)
+    {
+        // A repeated cell is a wait step (cooperative plans) and costs nothing
+        const bool bWait = i > 0 && CurrentPath[i] == CurrentPath[i - 1];
+        if (!bWait)
+            Cost += GridRef ? GridRef->GetTileMoveCost(CurrentPath[i]) : 1;
+    }
+    return Cost;
+}
+
+void AHexPawn::RecordPathStepCosts()
+{
+    PathStepCosts.SetNumUninitialized(CurrentPath.Num(), EAllowShrinking::No);
+    for (int32 i = 0; i < CurrentPath.Num(); ++i)
+        PathStepCosts[i] = uint8(GridRef->GetTileMoveCost(CurrentPath[i]));
+}
+
+bool AHexPawn::RepairPath()
+{
+    PathGridVersion = GridRef->GetGridVersion();
+    if (!bHasCurrentCoords)
+        return false;
+
+    // O(path): most changes touch tiles off the route, and a cheaper step never needs a new one
+    bool bHasWait = false;
+    bool bStepBroken = false;
+    for (int32 i = 1; i < CurrentPath.Num(); ++i)
+    {
+        if (CurrentPath[i] == CurrentPath[i - 1])
+        {
+            bHasWait = true;
+            continue;
+        }
+        const int32 Cost = GridRef->GetTileMoveCost(CurrentPath[i]);
+        bStepBroken |= i >= CurrentStepIndex && (Cost == 0 || Cost > PathStepCosts[i]);
+    }
+
+    if (bStepBroken && bHasWait)
+    {
+        // Wait steps are timed against the other agents' reservations: a lone re-route would ignore them
+        UE_LOG(LogHexPath, Warning, TEXT("[Move] Cooperative path blocked ahead of (%d,%d). Stop."), CurrentCoords.Q, CurrentCoords.R);
+        return false;
+    }
+
+    if (bStepBroken)
+    {
+        if (PathBudgetLeft <= 0)
+            return false;
+
+        // First repair of this move: one full search on the new grid. Later ones on a grid of the
+        // same size move the start and patch only the changed tiles; anything else starts over
+        const FHexAxialCoordinates Goal = PathGoal;
+        if (!Replanner)
+            Replanner = MakeShared<FHexDStarLite>();
+        const bool bRepaired = bReplannerSeeded && Replanner->IsInitialized() &&
+                               Replanner->MoveStart(*GridRef, CurrentCoords) && Replanner->SyncWithGrid(*GridRef);
+        bReplannerSeeded = true;
+        if (!bRepaired && !Replanner->Initialize(*GridRef, CurrentCoords, Goal))
+            return false;
+
+        // Never spend more than what was left of the original move
+        TArray<FHexAxialCoordinates> NewPath;
+        if (!Replanner->ExtractPath(*GridRef, PathBudgetLeft, NewPath))
+        {
+            UE_LOG(LogHexPath, Warning, TEXT("[Move] No route left to (%d,%d) after grid change. Stop."), Goal.Q, Goal.R);
+            return false;
+        }
+        HEX_VALIDATE_PATH(NewPath, TEXT("D* Lite"), false);
+
+        UE_LOG(LogHexPath, Log, TEXT("[Move] Path repaired from (%d,%d): %d steps, %d vertices expanded"),
+               CurrentCoords.Q, CurrentCoords.R, NewPath.Num() - 1, Replanner->GetLastExpanded());
+        CurrentPath = MoveTemp(NewPath);
+        CurrentStepIndex = 1;
+    }
+
+    // D* Lite only sees grid costs; the zone of control may also have moved under a kept path
+    if (!bHasWait)
+        StopAtZoneOfControl();
+    RecordPathStepCosts();
+    return true;
+}
+
+void AHexPawn::StopAtZoneOfControl()
+{
+    ADemoGameMode *GM = GetWorld() ? GetWorld()->GetAuthGameMode<ADemoGameMode>() : nullptr;
+    if (!GM || !GM->bEnemyZoneOfControl)
+        return;
+
+    // Same rule as the range the path came from: entering the zone ends the move
+    FHexRangeRules Rules;
+    GM->BuildRangeRules(0, Rules);
+    for (int32 i = CurrentStepIndex; i < CurrentPath.Num() - 1; ++i)
+    {
+        if (Rules.IsZoneOfControl(GridRef->GetTileIndex(CurrentPath[i])))
+        {
+            CurrentPath.SetNum(i + 1);
+            return;
+        }
+    }
+}
+
 void AHexPawn::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
 
     if (!bIsMoving)
     {
+        // Reachability is refreshed on arrival / grid change, not per idle frame
         if (HasAuthority() && SpriteComp)
             SpriteComp->SetAnimationState(EHexAnimState::Idle);
-
-        if (ADemoGameMode* GM = GetWorld()->GetAuthGameMode<ADemoGameMode>())
-            GM->UpdateReachableVisibility(3);
         return;
     }
 
@@ -201,16 +314,27 @@ void AHexPawn::Tick(float DeltaTime)
         // Snap to target of the current step
         SetActorLocation(TargetLocation);
 
-        // Update current tile based on where we just landed
+        // Update current cell based on where we just landed
         if (GridRef && CurrentPath.IsValidIndex(CurrentStepIndex))
         {
-            if (AHexTile* Landed = GridRef->GetHexTileAt(CurrentPath[CurrentStepIndex]))
-                CurrentTile = Landed;
+            const bool bMoved = !bHasCurrentCoords || !(CurrentCoords == CurrentPath[CurrentStepIndex]);
+            CurrentCoords = CurrentPath[CurrentStepIndex];
+            bHasCurrentCoords = true;
+            CurrentTile = GridRef->GetHexTileAt(CurrentCoords); // null in instanced mode
+            if (bMoved)
+                PathBudgetLeft -= GridRef->GetTileMoveCost(CurrentCoords);
         }
 
         // Advance to next step
         ++CurrentStepIndex;
 
+        // Tiles changed under the path: re-route from here (an empty path ends the move below)
+        if (GridRef && HasAuthority() && bRepairPathOnGridChange && GridRef->GetGridVersion() != PathGridVersion &&
+            CurrentPath.IsValidIndex(CurrentStepIndex) && !RepairPath())
+        {
+            CurrentPath.Reset();
+        }
+
         // Finished path?
         if (!GridRef || !CurrentPath.IsValidIndex(CurrentStepIndex))
         {
@@ -221,14 +345,14 @@ void AHexPawn::Tick(float DeltaTime)
             if (ADemoGameMode* GM = GetWorld()->GetAuthGameMode<ADemoGameMode>())
             {
                 GM->OnPawnArrived(this);          // <-- trigger tile effects (enemy, etc.)
-                GM->UpdateReachableVisibility(3);
+                GM->UpdateReachableVisibility(GM->PawnMovementPoints);
             }
             return;
         }
 
         // Prepare next step
-        AHexTile* NextTile = GridRef->GetHexTileAt(CurrentPath[CurrentStepIndex]);
-        if (!NextTile)
+        FVector NextLocation;
+        if (!GridRef->GetTileWorldLocation(CurrentPath[CurrentStepIndex], NextLocation))
         {
             bIsMoving = false;
             if (HasAuthority() && SpriteComp)
@@ -237,20 +361,20 @@ void AHexPawn::Tick(float DeltaTime)
             if (ADemoGameMode* GM = GetWorld()->GetAuthGameMode<ADemoGameMode>())
             {
                 GM->OnPawnArrived(this);
-                GM->UpdateReachableVisibility(3);
+                GM->UpdateReachableVisibility(GM->PawnMovementPoints);
             }
             return;
         }
 
-        // Optional sanity: require adjacency
-        if (CurrentTile && GridRef)
+        // Optional sanity: require adjacency (or a wait on the same cell, one StepDuration long)
+        if (bHasCurrentCoords && GridRef)
         {
-            const FHexAxialCoordinates Cur  = CurrentTile->GetAxialCoordinates();
+            const FHexAxialCoordinates Cur  = CurrentCoords;
             const FHexAxialCoordinates Next = CurrentPath[CurrentStepIndex];
-            const bool bAdjacent = GridRef->GetNeighbors(Cur).Contains(Next);
-            if (!bAdjacent || !GridRef->GetHexTileAt(Next))
+            const bool bAdjacent = Next == Cur || GridRef->AreNeighbors(Cur, Next);
+            if (!bAdjacent || !GridRef->HasTileAt(Next))
             {
-                UE_LOG(LogTemp, Warning, TEXT("[Move] Invalid step: (%d,%d)->(%d,%d). Stop."),
+                UE_LOG(LogHexPath, Warning, TEXT("[Move] Invalid step: (%d,%d)->(%d,%d). Stop."),
                        Cur.Q, Cur.R, Next.Q, Next.R);
 
                 bIsMoving = false;
@@ -260,14 +384,14 @@ void AHexPawn::Tick(float DeltaTime)
                 if (ADemoGameMode* GM = GetWorld()->GetAuthGameMode<ADemoGameMode>())
                 {
                     GM->OnPawnArrived(this);
-                    GM->UpdateReachableVisibility(3);
+                    GM->UpdateReachableVisibility(GM->PawnMovementPoints);
                 }
                 return;
             }
         }
 
         StartLocation = GetActorLocation();
-        TargetLocation = NextTile->GetActorLocation();
+        TargetLocation = NextLocation;
         StepElapsed = 0.f;
         bIsMoving = true;
 
@@ -278,6 +402,20 @@ void AHexPawn::Tick(float DeltaTime)
 void AHexPawn::SetCurrentTile(AHexTile *NewTile)
 {
     CurrentTile = NewTile;
+    if (NewTile)
+    {
+        CurrentCoords = NewTile->GetAxialCoordinates();
+        bHasCurrentCoords = true;
+    }
+}
+
+void AHexPawn::SetCurrentCoords(const FHexAxialCoordinates &NewCoords, UHexGridManager *InGrid)
+{
+    if (InGrid)
+        GridRef = InGrid;
+    CurrentCoords = NewCoords;
+    bHasCurrentCoords = true;
+    CurrentTile = GridRef ? GridRef->GetHexTileAt(NewCoords) : nullptr;
 }
 
 void AHexPawn::InitializePawnStartTile(const FHexAxialCoordinates &StartCoords)
@@ -294,16 +432,16 @@ void AHexPawn::InitializePawnStartTile(const FHexAxialCoordinates &StartCoords)
     if (!Grid)
         return;
 
-    AHexTile *Tile = Grid->GetHexTileAt(StartCoords);
-    if (!Tile)
+    FVector StartLocationWS;
+    if (!Grid->GetTileWorldLocation(StartCoords, StartLocationWS))
     {
-        UE_LOG(LogTemp, Error, TEXT("InitializePawnStartTile: No tile at (%d,%d)"), StartCoords.Q, StartCoords.R);
+        UE_LOG(LogHexGrid, Error, TEXT("InitializePawnStartTile: No tile at (%d,%d)"), StartCoords.Q, StartCoords.R);
         return;
     }
 
-    CurrentTile = Tile;
-    SetActorLocation(Tile->GetActorLocation());
-    UE_LOG(LogTemp, Warning, TEXT("Pawn initialized on tile (%d,%d)"), StartCoords.Q, StartCoords.R);
+    SetCurrentCoords(StartCoords, Grid);
+    SetActorLocation(StartLocationWS);
+    UE_LOG(LogHexGrid, Log, TEXT("Pawn initialized on tile (%d,%d)"), StartCoords.Q, StartCoords.R);
 }
 
 void AHexPawn::GetLifetimeReplicatedProps(TArray<FLifetimeProperty> &OutLifetimeProps) const
@@ -329,6 +467,14 @@ void AHexPawn::OnRep_CurrentPath()
 
 void AHexPawn::ServerRequestMove_Implementation(const TArray<FHexAxialCoordinates> &NewPath)
 {
+    // Client paths are checked against the same movement range that drives visibility
+    ADemoGameMode *GM = GetWorld()->GetAuthGameMode<ADemoGameMode>();
+    if (GM && !GM->ValidatePawnMove(this, NewPath))
+    {
+        UE_LOG(LogHexPath, Warning, TEXT("[Move] Rejected client path (%d steps) from %s"), NewPath.Num(), *GetName());
+        return;
+    }
+
     ReplicatedPath = NewPath;
     StartPathFollowing(NewPath, GridRef);
 }
@@ -1,4 +1,5 @@
 #include "HexSpriteComponent.h"
+#include "Demo.h"
 #include "Net/UnrealNetwork.h"
 
 UHexSpriteComponent::UHexSpriteComponent()
@@ -12,19 +13,19 @@ void UHexSpriteComponent::SetAnimationState(EHexAnimState NewState)
     if (CurrentAnimState == NewState)
         return;
     CurrentAnimState = NewState;
-    UE_LOG(LogTemp, Warning, TEXT("[SpriteComp %s] SetAnimationState -> %s | Owner=%s IsCDO=%d"),
-           *GetName(),
-           *UEnum::GetValueAsString(NewState),
-           *GetNameSafe(GetOwner()),
-           HasAnyFlags(RF_ClassDefaultObject) ? 1 : 0);
+    HEX_LOG_SAMPLED(LogHexAnim, Verbose, TEXT("[SpriteComp %s] SetAnimationState -> %s | Owner=%s IsCDO=%d"),
+                    *GetName(),
+                    *UEnum::GetValueAsString(NewState),
+                    *GetNameSafe(GetOwner()),
+                    HasAnyFlags(RF_ClassDefaultObject) ? 1 : 0);
     ApplyAnim();
 }
 
 void UHexSpriteComponent::OnRep_AnimState()
 {
-    UE_LOG(LogTemp, Warning, TEXT("[SpriteComp %s] OnRep_AnimState -> %s"),
-           *GetOwner()->GetName(),
-           *UEnum::GetValueAsString(CurrentAnimState));
+    HEX_LOG_SAMPLED(LogHexAnim, Verbose, TEXT("[SpriteComp %s] OnRep_AnimState -> %s"),
+                    *GetNameSafe(GetOwner()),
+                    *UEnum::GetValueAsString(CurrentAnimState));
     ApplyAnim();
 }
 
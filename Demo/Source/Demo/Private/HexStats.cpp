@@ -0,0 +1,100 @@
+#include "HexStats.h"
+#include "HAL/PlatformTime.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+DEFINE_STAT(STAT_HexGridRebuild);
+DEFINE_STAT(STAT_HexGridSpawn);
+DEFINE_STAT(STAT_HexFindPath);
+DEFINE_STAT(STAT_HexFindPathAsync);
+DEFINE_STAT(STAT_HexFindPathHierarchical);
+DEFINE_STAT(STAT_HexMovementRange);
+DEFINE_STAT(STAT_HexPathTree);
+DEFINE_STAT(STAT_HexFlowField);
+DEFINE_STAT(STAT_HexCooperativePlan);
+DEFINE_STAT(STAT_HexPreview);
+DEFINE_STAT(STAT_HexCursorHover);
+DEFINE_STAT(STAT_HexBattleStep);
+
+DEFINE_STAT(STAT_HexPathQueries);
+DEFINE_STAT(STAT_HexPathCacheHits);
+DEFINE_STAT(STAT_HexNodesExpanded);
+DEFINE_STAT(STAT_HexPathLength);
+
+DEFINE_STAT(STAT_HexRebuildTiles);
+DEFINE_STAT(STAT_HexRebuildTraces);
+DEFINE_STAT(STAT_HexRebuildSpawns);
+DEFINE_STAT(STAT_HexRebuildMs);
+
+#if HEX_TRACE_ENABLED
+
+UE_TRACE_CHANNEL_DEFINE(HexChannel)
+
+UE_TRACE_EVENT_BEGIN(Hex, Query)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint8, Kind)
+	UE_TRACE_EVENT_FIELD(int32, NodesExpanded)
+	UE_TRACE_EVENT_FIELD(int32, PathLength)
+	UE_TRACE_EVENT_FIELD(bool, CacheHit)
+	UE_TRACE_EVENT_FIELD(bool, Found)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(Hex, Rebuild)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(int32, Tiles)
+	UE_TRACE_EVENT_FIELD(int32, GroundTraces)
+	UE_TRACE_EVENT_FIELD(int32, Spawned)
+	UE_TRACE_EVENT_FIELD(bool, FromBake)
+	UE_TRACE_EVENT_FIELD(float, DurationMs)
+UE_TRACE_EVENT_END()
+
+// Courbes dans le panneau Counters d'Insights (dernière valeur enregistrée)
+TRACE_DECLARE_INT_COUNTER(HexQueryNodesExpanded, TEXT("Hex/Query/NodesExpanded"));
+TRACE_DECLARE_INT_COUNTER(HexQueryPathLength, TEXT("Hex/Query/PathLength"));
+TRACE_DECLARE_FLOAT_COUNTER(HexRebuildMs, TEXT("Hex/Rebuild/DurationMs"));
+
+#endif
+
+#if HEX_STATS_ENABLED
+
+void HexStats::RecordQuery(const FHexQueryMetrics& Metrics)
+{
+	INC_DWORD_STAT(STAT_HexPathQueries);
+	if (Metrics.bCacheHit)
+		INC_DWORD_STAT(STAT_HexPathCacheHits);
+	INC_DWORD_STAT_BY(STAT_HexNodesExpanded, Metrics.NodesExpanded);
+	INC_DWORD_STAT_BY(STAT_HexPathLength, Metrics.PathLength);
+
+#if HEX_TRACE_ENABLED
+	UE_TRACE_LOG(Hex, Query, HexChannel)
+		<< Query.Cycle(FPlatformTime::Cycles64())
+		<< Query.Kind(uint8(Metrics.Kind))
+		<< Query.NodesExpanded(Metrics.NodesExpanded)
+		<< Query.PathLength(Metrics.PathLength)
+		<< Query.CacheHit(Metrics.bCacheHit)
+		<< Query.Found(Metrics.bFound);
+	TRACE_COUNTER_SET(HexQueryNodesExpanded, Metrics.NodesExpanded);
+	TRACE_COUNTER_SET(HexQueryPathLength, Metrics.PathLength);
+#endif
+}
+
+void HexStats::RecordRebuild(const FHexRebuildMetrics& Metrics)
+{
+	const float DurationMs = float(Metrics.Seconds * 1000.0);
+	SET_DWORD_STAT(STAT_HexRebuildTiles, Metrics.Tiles);
+	SET_DWORD_STAT(STAT_HexRebuildTraces, Metrics.GroundTraces);
+	SET_DWORD_STAT(STAT_HexRebuildSpawns, Metrics.Spawned);
+	SET_FLOAT_STAT(STAT_HexRebuildMs, DurationMs);
+
+#if HEX_TRACE_ENABLED
+	UE_TRACE_LOG(Hex, Rebuild, HexChannel)
+		<< Rebuild.Cycle(FPlatformTime::Cycles64())
+		<< Rebuild.Tiles(Metrics.Tiles)
+		<< Rebuild.GroundTraces(Metrics.GroundTraces)
+		<< Rebuild.Spawned(Metrics.Spawned)
+		<< Rebuild.FromBake(Metrics.bFromBake)
+		<< Rebuild.DurationMs(DurationMs);
+	TRACE_COUNTER_SET(HexRebuildMs, DurationMs);
+#endif
+}
+
+#endif // HEX_STATS_ENABLED
@@ -1,5 +1,6 @@
 // HexTile.cpp
 #include "HexTile.h"
+#include "Demo.h"
 #include "Components/SceneComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "Kismet/GameplayStatics.h"
@@ -66,7 +67,7 @@ void AHexTile::BeginPlay()
     }
     else
     {
-        UE_LOG(LogTemp, Error, TEXT("HexTile: no visual mesh found on %s"), *GetName());
+        UE_LOG(LogHexGrid, Error, TEXT("HexTile: no visual mesh found on %s"), *GetName());
     }
 }
 
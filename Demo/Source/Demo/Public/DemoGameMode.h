@@ -4,6 +4,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/GameModeBase.h"
 #include "HexCoordinates.h"
+#include "HexMovementRange.h"
 #include "Blueprint/UserWidget.h" // add (or: forward declare class UUserWidget;)
 #include "DemoGameMode.generated.h"
 
@@ -35,6 +36,10 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Hex|Input")
     void HandleTileClicked(AHexTile *ClickedTile);
 
+    /** Click handler by cell; works in both grid render modes */
+    UFUNCTION(BlueprintCallable, Category = "Hex|Input")
+    void HandleCellClicked(const FHexAxialCoordinates &Cell);
+
     /** Accessors for managers */
     UFUNCTION(BlueprintPure, Category = "Hex")
     UHexGridManager *GetHexGridManager() const { return GridManager; }
@@ -51,6 +56,7 @@ public:
 
     /** Hover preview controls */
     void PreviewPathTo(AHexTile *GoalTile);
+    void PreviewPathToCell(const FHexAxialCoordinates &GoalCell);
     void ClearPreview();
 
     UFUNCTION(BlueprintCallable, Category = "Hex|PathPreview")
@@ -66,12 +72,37 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Hex|Gameplay")
     void OpenShopAt(AHexTile *ShopTile);
 
+    /** Open shop UI (tile-independent) */
+    UFUNCTION(BlueprintCallable, Category = "Hex|Gameplay")
+    void OpenShopWidget();
+
     /** Initial axial coordinates for the player pawn */
     UPROPERTY(EditAnywhere, Category = "Hex|Start")
     FHexAxialCoordinates StartCoords = FHexAxialCoordinates(0, 6);
 
+    /**
+     * Show only tiles the pawn can reach with MovementPoints (terrain costs, zone of control).
+     * No-op unless the pawn tile, budget or grid changed.
+     */
     UFUNCTION(BlueprintCallable, Category = "Hex|Visibility")
-    void UpdateReachableVisibility(int32 MaxSteps);
+    void UpdateReachableVisibility(int32 MovementPoints);
+
+    /** Movement points of every pawn's move: range, preview, clicks and server validation */
+    UPROPERTY(EditAnywhere, Category = "Hex|Movement", meta = (ClampMin = "1"))
+    int32 PawnMovementPoints = 3;
+
+    /** Enemy tiles and their neighbours stop movement (zone of control) */
+    UPROPERTY(EditAnywhere, Category = "Hex|Movement")
+    bool bEnemyZoneOfControl = false;
+
+    /** Last range computed for the player pawn (drives visibility, hover and move validation) */
+    const FHexMovementRange &GetReachableRange() const { return ReachableRange; }
+
+    /** Server-side check of a client-requested path against the pawn's movement range */
+    bool ValidatePawnMove(const AHexPawn *Pawn, const TArray<FHexAxialCoordinates> &Path);
+
+    /** Range rules for a budget: terrain costs, plus enemy zone of control when enabled */
+    void BuildRangeRules(int32 MovementPoints, FHexRangeRules &OutRules) const;
 
     UPROPERTY(EditAnywhere, Category = "UI")
     TSubclassOf<UUserWidget> PlayerStatsWidgetClass;
@@ -101,6 +132,7 @@ protected:
     /** Engine lifecycle */
     virtual void BeginPlay() override;
     virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual void Tick(float DeltaSeconds) override;
 
     /** Post-login hooks to finish initial snapping */
     virtual void PostLogin(APlayerController *NewPlayer) override;
@@ -141,24 +173,32 @@ protected:
     AHexAnimationManager *AnimationManager = nullptr;
 
 private:
-    /** Preview throttle */
-    FTimerHandle PreviewThrottle;
-
-    /** Hover target and caching to avoid recompute */
-    TWeakObjectPtr<AHexTile> PendingGoal;
+    /** Hover target and caching to avoid redrawing the same preview */
+    FHexAxialCoordinates PendingGoal;
+    bool bHasPendingGoal = false;
     FHexAxialCoordinates LastStart{INT32_MAX, INT32_MAX};
     FHexAxialCoordinates LastGoal{INT32_MAX, INT32_MAX};
+    uint32 LastPreviewGridVersion = 0;
 
     /** Keep a weak ref to shop widget to avoid double-destroy */
     UPROPERTY()
     TWeakObjectPtr<UUserWidget> ShopWidget;
 
-    /** Periodic preview update */
-    void DoPreviewTick();
+    /** Redraw the preview for PendingGoal, read off the pathfinder's shortest-path tree */
+    void UpdatePreview();
 
     /** Typed pawn getter */
     AHexPawn *GetPlayerPawnTyped() const;
 
+    /** Grid cells -> world points for PathView */
+    void BuildPathPoints(const TArray<FHexAxialCoordinates> &AxialPath, TArray<FVector> &OutPoints) const;
+
+    /** Cursor picking: one ray/plane intersection per frame, no per-tile collision or cursor events */
+    int32 HoveredTileIndex = INDEX_NONE;
+    void UpdateCursorHover();
+    void HandleCursorClick();
+    int32 GetTileIndexUnderCursor() const;
+
     /** Preview toggle */
     UPROPERTY(EditAnywhere, Category = "Hex|PathPreview")
     bool bPreviewEnabled = true;
@@ -175,4 +215,21 @@ private:
 
     FRandomStream EnemyRNG;
     FName PickRandomEnemyIdFromCatalog() const;
+
+    /** Grid change hook: refreshes reachability while the pawn is idle */
+    void HandleGridChanged(int32 TileIndex);
+
+    /** Player range (origin, budget and grid version double as the cache key); applied visibility lives on the grid */
+    FHexMovementRange ReachableRange;
+    int32 ReachableBudget = INDEX_NONE;
+    bool bReachableVisibilityStale = false;
+
+    /** Recompute ReachableRange if the pawn tile, budget or grid changed; no visibility side effects */
+    bool RefreshReachableRange(int32 MovementPoints);
+
+    /** ReachableRange was computed from Start on the current grid */
+    bool IsReachableRangeCurrentFrom(const FHexAxialCoordinates &Start) const;
+
+    /** Route drawn for a hovered goal: from the player range when current, else from the unconstrained path tree */
+    bool GetPreviewPath(const FHexAxialCoordinates &Start, const FHexAxialCoordinates &Goal, TArray<FHexAxialCoordinates> &OutPath);
 };
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HexCoordinates.h"
+
+class UHexGridManager;
+
+/**
+ * Couche hiérarchique (HPA*) au-dessus de UHexGridManager, pour les grandes grilles.
+ * - Grille découpée en clusters losanges de ClusterSize x ClusterSize hex (axial q = Q/2, r = R)
+ * - Entre deux clusters voisins : une transition par segment de frontière contigu (paire du milieu)
+ * - Coûts entre entrées d'un même cluster précalculés (Dijkstra borné au cluster)
+ * - Requête : A* sur le graphe abstrait (entrées + Start/Goal raccordés), puis raffinement
+ *   segment par segment, arrêté dès que le budget demandé est dépassé
+ * Un changement de tuile ne recalcule que son cluster (et les voisins dont les entrées bougent).
+ * Game thread uniquement, comme UHexPathFinder qui le possède.
+ */
+class DEMO_API FHexClusterGraph
+{
+public:
+	/** Côté d'un cluster en hex ; change tout le découpage (reconstruction au prochain appel) */
+	void SetClusterSize(int32 InSize);
+	int32 GetClusterSize() const { return ClusterSize; }
+
+	/** À brancher sur OnGridChanged : INDEX_NONE = tout reconstruire, sinon seul le cluster de la tuile */
+	void MarkTileChanged(int32 TileIndex);
+
+	/**
+	 * Chemin Start->Goal (Start et Goal inclus). Budget > 0 : seuls les segments utiles sont raffinés,
+	 * et le chemin s'arrête à la dernière tuile payable. False si aucun chemin.
+	 */
+	bool FindPath(const UHexGridManager& Grid, const FHexAxialCoordinates& Start, const FHexAxialCoordinates& Goal,
+	              int32 Budget, TArray<FHexAxialCoordinates>& OutPath);
+
+	int32 GetClusterCount() const { return Clusters.Num(); }
+	int32 GetAbstractNodeCount() const { return NodeTiles.Num(); }
+	int32 GetLastAbstractExpanded() const { return LastAbstractExpanded; }
+
+private:
+	struct FEdge
+	{
+		int32 To;    // noeud abstrait (graphe) ou tuile (Intra)
+		int32 Cost;
+	};
+
+	struct FIntraEdge
+	{
+		int32 From;  // tuiles (entrées du cluster)
+		int32 To;
+		int32 Cost;
+	};
+
+	struct FCluster
+	{
+		TArray<int32>      Tiles;
+		TArray<int32>      Neighbors;  // clusters voisins
+		TArray<int32>      Entrances;  // tuiles, triées
+		TArray<FIntraEdge> Intra;
+	};
+
+	/** Transition (tuile côté cluster bas, tuile côté cluster haut) d'une frontière */
+	struct FTransition
+	{
+		int32 Low;
+		int32 High;
+	};
+
+	int32 ClusterSize = 8;
+	bool  bNeedsPartition = true;
+	bool  bAdjacencyDirty = true;
+
+	TArray<int32>    TileCluster;  // index tuile -> cluster, INDEX_NONE si absente
+	TArray<FCluster> Clusters;
+	TMap<uint64, TArray<FTransition>> Borders; // clé = paire de clusters (bas, haut)
+	TSet<int32>      DirtyClusters;
+
+	// Graphe abstrait : un noeud par tuile d'entrée
+	TMap<int32, int32>     NodeOfTile;
+	TArray<int32>          NodeTiles;
+	TArray<TArray<FEdge>>  NodeEdges;
+	int32 LastAbstractExpanded = 0;
+
+	// Tampons de recherche (tuiles et noeuds abstraits), estampillés par génération
+	struct FSearchNode
+	{
+		int32  G = 0;
+		int32  Parent = INDEX_NONE;
+		uint32 Generation = 0;
+		bool   bClosed = false;
+	};
+	struct FOpenEntry
+	{
+		int32 F;
+		int32 H;
+		int32 Index;
+	};
+	TArray<FSearchNode> TileNodes;
+	TArray<FSearchNode> AbsNodes;
+	TArray<FOpenEntry>  Heap;
+	uint32 TileGeneration = 0;
+	uint32 AbsGeneration = 0;
+
+	static uint64 BorderKey(int32 A, int32 B) { return (uint64(uint32(FMath::Min(A, B))) << 32) | uint32(FMath::Max(A, B)); }
+
+	/** Découpage, puis recalcul des clusters sales et du graphe abstrait */
+	void Update(const UHexGridManager& Grid);
+	void Partition(const UHexGridManager& Grid);
+	void ComputeBorder(const UHexGridManager& Grid, int32 Low, int32 High);
+	void GatherEntrances(int32 ClusterId, TArray<int32>& OutEntrances) const;
+	void ComputeIntra(const UHexGridManager& Grid, int32 ClusterId);
+	void RebuildAdjacency(const UHexGridManager& Grid);
+
+	/**
+	 * Dijkstra / A* borné au cluster de Source. Goal != INDEX_NONE : arrêt au but (A*).
+	 * bReverse : coûts « pour aller de la tuile à Source » (entrées vers un but).
+	 */
+	void SearchInCluster(const UHexGridManager& Grid, int32 Source, int32 Goal, bool bReverse);
+	bool IsReached(int32 Tile) const { return TileNodes[Tile].Generation == TileGeneration; }
+
+	uint32 BeginGeneration(TArray<FSearchNode>& Nodes, uint32& Generation, int32 Count);
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HexCoordinates.h"
+#include <atomic>
+
+struct FHexGridSnapshot;
+
+/** Un agent du lot : départ, but. L'ordre dans le lot est la priorité (le premier réserve en premier). */
+struct DEMO_API FHexAgentMoveRequest
+{
+	FHexAxialCoordinates Start;
+	FHexAxialCoordinates Goal;
+};
+
+/**
+ * Plans d'un lot, un chemin par agent dans l'ordre de la requête.
+ * Un pas = un StepDuration pour tous les agents ; une case répétée = attente sur place.
+ * Chaque chemin se lit directement par AHexPawn::StartPathFollowing.
+ */
+struct DEMO_API FHexCooperativePlan
+{
+	uint32 RequestId = 0;
+	uint32 GridVersion = 0;
+	int32  Window = 0;
+	int32  NodesExpanded = 0;
+	TArray<TArray<FHexAxialCoordinates>> Paths;  // [Start] seul : l'agent reste sur place ; vide si bFailed
+	TArray<bool> bReachedGoal;
+	TArray<bool> bFailed;  // aucun plan sûr (hors grille, départ partagé, pas d'arrêt sûr dans l'horizon)
+};
+
+DECLARE_DELEGATE_OneParam(FOnHexCooperativePlan, const FHexCooperativePlan& /*Plan*/);
+
+/**
+ * Planification coopérative WHCA* (Silver) sur un snapshot : A* espace-temps par agent, dans l'ordre
+ * de priorité, contre une table de réservations (case, pas) et (arête, pas) remplie par les agents
+ * précédents. L'heuristique est la vraie distance au but (Dijkstra inverse), calculée en parallèle
+ * pour tous les agents. Horizon = Window pas : chaque agent s'arrête au but ou à la meilleure case
+ * sûre atteinte, puis y reste réservé. Les départs des agents suivants sont réservés dès le début.
+ * Les chemins rendus sont sans collision (case ni échange) ; un agent sans plan sûr est marqué bFailed.
+ */
+struct DEMO_API FHexCooperativePlanner
+{
+	/** Horizon max en pas ; la recherche ne garde que les états visités, pas Window * nombre de cases */
+	static constexpr int32 MaxWindow = 64;
+
+	/** Budget > 0 : points de mouvement max par agent (les attentes sont gratuites) */
+	static void Plan(const FHexGridSnapshot& Snap, TConstArrayView<FHexAgentMoveRequest> Agents, int32 Window, int32 Budget,
+	                 const std::atomic<bool>& Cancelled, FHexCooperativePlan& Out);
+};
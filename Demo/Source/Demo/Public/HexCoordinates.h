@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HexMath.h"
 #include "HexCoordinates.generated.h"
 
 USTRUCT(BlueprintType)
@@ -16,6 +17,10 @@ struct DEMO_API FHexAxialCoordinates
 
     FHexAxialCoordinates() = default;
     FHexAxialCoordinates(int32 InQ, int32 InR) : Q(InQ), R(InR) {}
+    explicit FHexAxialCoordinates(const HexMath::FCoord& C) : Q(C.Q), R(C.R) {}
+
+    // passage vers la lib de maths hex (mêmes labels doubled-q)
+    HexMath::FCoord ToHexMath() const { return HexMath::FCoord{Q, R}; }
 
     // opérateur == nécessaire pour TMap.Find(...)
     bool operator==(const FHexAxialCoordinates& Other) const
@@ -23,18 +28,47 @@ struct DEMO_API FHexAxialCoordinates
         return Q == Other.Q && R == Other.R;
     }
 
-    // distance hexagonale « manhattan » (axial coords)
+    // distance hexagonale entre labels doubled-q
     int32 DistanceTo(const FHexAxialCoordinates& Other) const
     {
-        const int32 dQ = FMath::Abs(Q - Other.Q);
-        const int32 dR = FMath::Abs(R - Other.R);
-        const int32 dS = FMath::Abs((Q + R) - (Other.Q + Other.R));
-        return (dQ + dR + dS) / 2;
+        return HexMath::Distance(ToHexMath(), Other.ToHexMath());
     }
 };
 
-// hash pour le TMap
+// hash pour le TMap : même multiply-add que FHexCoordKey (Q impair = label invalide, collision sans conséquence)
 FORCEINLINE uint32 GetTypeHash(const FHexAxialCoordinates& Coords)
 {
-    return HashCombine(::GetTypeHash(Coords.Q), ::GetTypeHash(Coords.R));
+    return HexMath::FPackedKey::Pack(Coords.ToHexMath()).Hash();
 }
+
+/**
+ * Clé compacte (deux int16 dans un uint32) pour les conteneurs indexés par coordonnée :
+ * moitié moins de mémoire que FHexAxialCoordinates, égalité et hash en une opération.
+ * Pour une grille bornée, ToTileIndex donne le hash parfait (index dense, cf. UHexGridManager::GetTileIndex).
+ */
+struct FHexCoordKey
+{
+    HexMath::FPackedKey Packed;
+
+    FHexCoordKey() = default;
+    /** Coords doit passer CanPack : sinon la clé en confond deux (ensure, puis clé tronquée) */
+    explicit FHexCoordKey(const FHexAxialCoordinates& Coords) : Packed(HexMath::FPackedKey::Pack(Coords.ToHexMath()))
+    {
+        ensureMsgf(CanPack(Coords), TEXT("FHexCoordKey: (%d,%d) is not a packable doubled-q label"), Coords.Q, Coords.R);
+    }
+
+    FHexAxialCoordinates ToCoords() const { return FHexAxialCoordinates(Packed.Unpack()); }
+
+    /** Label doubled-q représentable (Q pair, composantes dans int16) */
+    static bool CanPack(const FHexAxialCoordinates& Coords) { return HexMath::FPackedKey::CanPack(Coords.ToHexMath()); }
+
+    template <typename TConvention>
+    int32 ToTileIndex(int32 Radius) const { return Packed.TileIndex<TConvention>(Radius); }
+
+    bool operator==(const FHexCoordKey& Other) const { return Packed == Other.Packed; }
+    bool operator!=(const FHexCoordKey& Other) const { return Packed != Other.Packed; }
+
+    friend uint32 GetTypeHash(const FHexCoordKey& Key) { return Key.Packed.Hash(); }
+};
+
+static_assert(sizeof(FHexCoordKey) == sizeof(uint32), "FHexCoordKey doit rester sur 32 bits");
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HexCoordinates.h"
+
+class UHexGridManager;
+
+/**
+ * Replanification incrémentale D* Lite (Koenig & Likhachev) sur la grille dense.
+ * Recherche arrière depuis le but : g / rhs = coût restant jusqu'au but. Quand la grille change,
+ * seules les tuiles dont le coût d'entrée a bougé (et leurs voisins) sont remises dans la file ;
+ * le départ (tuile du pion) avance par MoveStart sans rien recalculer.
+ * Heuristique = distance hex (coût min 1) : reste cohérente quels que soient les changements de coûts.
+ * Game thread uniquement.
+ */
+class DEMO_API FHexDStarLite
+{
+public:
+	/** Première recherche Start->Goal ; false si l'une des deux tuiles n'existe pas ou si la recherche n'a pas convergé */
+	bool Initialize(const UHexGridManager& Grid, const FHexAxialCoordinates& Start, const FHexAxialCoordinates& Goal);
+
+	bool IsInitialized() const { return GoalIndex != INDEX_NONE; }
+	FHexAxialCoordinates GetGoal() const { return GoalCoords; }
+
+	/** Le pion a avancé : nouveau départ (km += h(ancien, nouveau)), pas de recherche */
+	bool MoveStart(const UHexGridManager& Grid, const FHexAxialCoordinates& NewStart);
+
+	/**
+	 * Compare les coûts connus à ceux de la grille, met à jour les tuiles changées puis répare.
+	 * False si la grille a changé de taille ou si la réparation n'a pas convergé : l'état est oublié,
+	 * il faut réinitialiser.
+	 */
+	bool SyncWithGrid(const UHexGridManager& Grid);
+
+	/** Chemin depuis le départ courant (inclus) ; Budget > 0 : tronqué à la dernière tuile payable */
+	bool ExtractPath(const UHexGridManager& Grid, int32 Budget, TArray<FHexAxialCoordinates>& OutPath) const;
+
+	/** Sommets développés par la dernière réparation (ou l'initialisation) */
+	int32 GetLastExpanded() const { return LastExpanded; }
+
+private:
+	static constexpr int32 Infinity = MAX_int32 / 4;
+
+	struct FKey
+	{
+		int32 K1 = 0;
+		int32 K2 = 0;
+		bool operator<(const FKey& O) const { return K1 < O.K1 || (K1 == O.K1 && K2 < O.K2); }
+		bool operator==(const FKey& O) const { return K1 == O.K1 && K2 == O.K2; }
+	};
+
+	struct FOpenEntry
+	{
+		FKey  Key;
+		int32 Index;
+	};
+
+	int32 Radius = INDEX_NONE;
+	bool  bOffsetOnQ = true;
+	int32 StartIndex = INDEX_NONE;
+	int32 GoalIndex = INDEX_NONE;
+	FHexAxialCoordinates GoalCoords;
+	int32 KM = 0;
+	int32 LastExpanded = 0;
+
+	TArray<int32> G;
+	TArray<int32> Rhs;
+	TArray<uint8> KnownCosts;  // coût d'entrée vu au dernier Sync (0 = infranchissable ou absente)
+	TArray<FKey>  OpenKeys;    // clé courante si InOpen
+	TBitArray<>   InOpen;
+	TArray<FOpenEntry> Heap;   // entrées périmées tolérées (clé différente ou plus dans la file)
+
+	int32 H(const UHexGridManager& Grid, int32 A, int32 B) const;
+	FKey CalculateKey(const UHexGridManager& Grid, int32 Index) const;
+	void UpdateVertex(const UHexGridManager& Grid, int32 Index);
+	/** False si le garde-fou d'expansions est atteint (l'état est alors invalidé) */
+	bool ComputeShortestPath(const UHexGridManager& Grid);
+
+	/** Fn(IndexVoisin) pour les 6 voisins dans le rayon indexé (présents ou non) */
+	template <typename FuncType>
+	void ForEachNeighbor(const UHexGridManager& Grid, int32 Index, FuncType&& Fn) const;
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HexCoordinates.h"
+#include "HexGridManager.h"
+
+/**
+ * Champ de flux (Dijkstra map) vers un ensemble de cibles, construit par UHexPathFinder::BuildFlowField.
+ * Pour chaque index dense : coût restant jusqu'à la cible la plus proche et direction du prochain pas
+ * (code 3 bits : 0..5 = GetNeighborDelta, 7 = aucune). Un agent lit son pas en O(1), sans recherche.
+ */
+struct DEMO_API FHexFlowField
+{
+	static constexpr uint8 NoDirection = 7;
+	static constexpr int32 Unreached = MAX_int32;
+
+	/** Version de la grille au moment du calcul ; champ périmé si elle a bougé */
+	uint32 GridVersion = 0;
+
+	/** Rayon / convention de la grille : suffisent pour passer coordonnées -> index */
+	int32 Radius = INDEX_NONE;
+	bool  bOffsetOnQ = true;
+
+	TArray<int32> Distances;  // Unreached = hors d'atteinte ou case absente
+	TArray<uint8> Directions; // code 3 bits, NoDirection sur les cibles et les cases non atteintes
+	TArray<FHexAxialCoordinates> Targets; // cibles (distance 0)
+
+	bool IsValid() const { return Distances.Num() > 0; }
+
+	int32 GetIndex(const FHexAxialCoordinates& Coords) const
+	{
+		return UHexGridManager::ComputeTileIndex(Coords, Radius, bOffsetOnQ);
+	}
+
+	/** Coût restant depuis Coords ; INDEX_NONE si hors d'atteinte */
+	int32 GetDistance(const FHexAxialCoordinates& Coords) const
+	{
+		const int32 Index = GetIndex(Coords);
+		return (Distances.IsValidIndex(Index) && Distances[Index] != Unreached) ? Distances[Index] : INDEX_NONE;
+	}
+
+	/** Prochain pas vers la cible la plus proche ; false sur une cible ou hors d'atteinte */
+	bool GetNextStep(const FHexAxialCoordinates& From, FHexAxialCoordinates& OutNext) const
+	{
+		const int32 Index = GetIndex(From);
+		if (!Directions.IsValidIndex(Index) || Directions[Index] == NoDirection)
+			return false;
+		const int32 Dir = Directions[Index];
+		OutNext = FHexAxialCoordinates{From.Q + HexMath::NeighborDQ[Dir], From.R + HexMath::NeighborDR[Dir]};
+		return true;
+	}
+
+	/** Pas qui éloigne le plus des cibles (fuite) : voisin atteint de plus grande distance ; false si aucun ne l'augmente */
+	bool GetFleeStep(const FHexAxialCoordinates& From, FHexAxialCoordinates& OutNext) const
+	{
+		const int32 Index = GetIndex(From);
+		if (!Distances.IsValidIndex(Index))
+			return false;
+
+		int32 Best = Distances[Index] == Unreached ? INDEX_NONE : Distances[Index];
+		bool bFound = false;
+		for (int32 Dir = 0; Dir < 6; ++Dir)
+		{
+			const FHexAxialCoordinates N{From.Q + HexMath::NeighborDQ[Dir], From.R + HexMath::NeighborDR[Dir]};
+			const int32 NIdx = GetIndex(N);
+			if (NIdx == INDEX_NONE || Distances[NIdx] == Unreached || Distances[NIdx] <= Best)
+				continue;
+			Best = Distances[NIdx];
+			OutNext = N;
+			bFound = true;
+		}
+		return bFound;
+	}
+};
@@ -2,15 +2,50 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "HexCoordinates.h"
+#include "HexTile.h"
+#include "WorldCollision.h"
 #include "HexGridManager.generated.h"
 
-class AHexTile;
+class UHierarchicalInstancedStaticMeshComponent;
+class UStaticMesh;
+class UMaterialInterface;
+struct FHexGridSnapshot;
+
+/** Mode de rendu de la grille */
+UENUM(BlueprintType)
+enum class EHexGridRenderMode : uint8
+{
+    /** Un AHexTile par case (collision, événements souris et MID par tuile) */
+    Actors    UMETA(DisplayName = "Actors"),
+    /** Une seule HISM pour toute la grille ; état visuel en custom data par instance */
+    Instanced UMETA(DisplayName = "Instanced"),
+};
+
+/** Disposition des PerInstanceCustomData en mode Instanced (à lire dans le matériau) */
+namespace HexInstanceData
+{
+    constexpr int32 Type = 0;      // EHexTileType en float
+    constexpr int32 Highlight = 1; // 0/1
+    constexpr int32 Elevation = 2; // décalage Z (World Position Offset)
+    constexpr int32 Visible = 3;   // 0/1 (masque d'opacité)
+    constexpr int32 Num = 4;
+}
+
+/** Grille modifiée : index de la tuile touchée, ou INDEX_NONE si toute la grille a été reconstruite */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnHexGridChanged, int32 /*TileIndex*/);
+
+/** Progression de la génération [0,1] ; 1 = tuiles créées (OnGridChanged suit) */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnHexGridGenerationProgress, float /*Fraction*/);
 
 /**
  * Gère la génération et l'indexation d'une grille hexagonale (axial Q,R).
  * - Placement XY inspiré de l'ancienne version (offset demi-ligne sur parité configurable)
  * - Z déterminé par un line trace vertical (ECC_Visibility + fallback Static/Dynamic)
  * - Stockage des tuiles et requêtes (GetHexTileAt / GetNeighbors)
+ *
+ * Stockage dense : la grille générée est un hexagone (Col,Row) de rayon GridRadius, donc
+ * coordonnée -> index se calcule en forme close (GetTileIndex). Les données par tuile
+ * sont rangées en tableaux parallèles (acteur, type, hauteur, masque de voisins).
  */
 UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
 class DEMO_API UHexGridManager : public UActorComponent
@@ -23,6 +58,7 @@ public:
 
     // --- API ---
 
+    /** Parcourt les tuiles existantes dans l'ordre des index (acteur éventuellement nul) */
     void ForEachTile(TFunctionRef<void(const FHexAxialCoordinates&, AHexTile*)> Fn) const;
     /** Génère la grille (rayon en tuiles, et classe de tuile à instancier) */
     UFUNCTION(BlueprintCallable, Category = "Hex|Generation")
@@ -32,15 +68,179 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Hex|Query")
     AHexTile *GetHexTileAt(const FHexAxialCoordinates &Coords) const;
 
-    /** Renvoie la liste des voisins existants autour d’une coordonnée */
+    /** Renvoie la liste des voisins existants autour d’une coordonnée (alloue : réservé au BP/outillage) */
     UFUNCTION(BlueprintCallable, Category = "Hex|Query")
     TArray<FHexAxialCoordinates> GetNeighbors(const FHexAxialCoordinates &Coords) const;
 
-    /** Accès lecture à la map des tuiles (utile pour pathfinding etc.) */
-    const TMap<FHexAxialCoordinates, TWeakObjectPtr<AHexTile>>& GetHexTiles() const { return TilesMap; }
+    /** Voisins existants sans allocation ; renvoie le nombre d'entrées valides dans Out */
+    int32 GetNeighborsInto(const FHexAxialCoordinates &Coords, TStaticArray<FHexAxialCoordinates, 6> &Out) const;
+
+    /** Appelle Fn(Voisin) pour chaque voisin existant (masque précalculé, aucune allocation) */
+    template <typename FuncType>
+    void ForEachNeighbor(const FHexAxialCoordinates &Coords, FuncType &&Fn) const
+    {
+        const int32 Index = GetTileIndex(Coords);
+        if (Index == INDEX_NONE)
+            return;
+        for (uint32 Mask = NeighborMasks[Index]; Mask; Mask &= Mask - 1)
+        {
+            const int32 Dir = FMath::CountTrailingZeros(Mask);
+            Fn(FHexAxialCoordinates{Coords.Q + HexMath::NeighborDQ[Dir], Coords.R + HexMath::NeighborDR[Dir]});
+        }
+    }
+
+    /** Variante par index : Fn(IndexVoisin, Direction) */
+    template <typename FuncType>
+    void ForEachNeighborIndex(int32 Index, FuncType &&Fn) const
+    {
+        WithTileIndexer([&](const auto &Indexer) { ForEachNeighborIndex(Indexer, Index, Fn); });
+    }
+
+    /** Variante pour les boucles chaudes : convention résolue à la compilation (indexeur fourni par WithTileIndexer) */
+    template <typename TConvention, typename FuncType>
+    void ForEachNeighborIndex(const HexMath::TTileIndexer<TConvention> &Indexer, int32 Index, FuncType &&Fn) const
+    {
+        const HexMath::FCoord C = TileCoords[Index].ToHexMath();
+        for (uint32 Mask = NeighborMasks[Index]; Mask; Mask &= Mask - 1)
+        {
+            const int32 Dir = FMath::CountTrailingZeros(Mask);
+            Fn(Indexer.NeighborIndexOf(C, Dir), Dir);
+        }
+    }
+
+    /**
+     * Fn(TTileIndexer<Convention>) avec la convention de cette grille : une seule instanciation de Fn par
+     * convention, aucun test de bOffsetOnQ dans la boucle.
+     */
+    template <typename FuncType>
+    decltype(auto) WithTileIndexer(FuncType &&Fn) const
+    {
+        return HexMath::DispatchConvention(bOffsetOnQ, IndexedRadius, Forward<FuncType>(Fn));
+    }
+
+    /** A et B sont deux tuiles existantes et adjacentes ? */
+    bool AreNeighbors(const FHexAxialCoordinates &A, const FHexAxialCoordinates &B) const;
+
+    /** Masque des voisins existants d'une coordonnée (0 si hors grille) */
+    uint8 GetNeighborMaskAt(const FHexAxialCoordinates &Coords) const
+    {
+        const int32 Index = GetTileIndex(Coords);
+        return Index != INDEX_NONE ? NeighborMasks[Index] : 0;
+    }
+
+    /** Index dense O(1) (sans hash) d'une coordonnée de la grille bornée ; INDEX_NONE si hors grille */
+    int32 GetTileIndex(const FHexAxialCoordinates &Coords) const;
+
+    /** Forme close de GetTileIndex pour un rayon / une convention donnés (partagée avec FHexGridSnapshot) */
+    static int32 ComputeTileIndex(const FHexAxialCoordinates &Coords, int32 Radius, bool bInOffsetOnQ);
+
+    /** Inverse de GetTileIndex */
+    FHexAxialCoordinates GetTileCoords(int32 Index) const;
+
+    /** Nombre d'index possibles (taille à donner aux tableaux indexés par tuile) */
+    int32 GetTileIndexCount() const { return TileCoords.Num(); }
+
+    /** Rayon de l'hexagone indexé (à passer à ComputeTileIndex avec bOffsetOnQ) */
+    int32 GetIndexedRadius() const { return IndexedRadius; }
+
+    /** Tuile présente à cet index ? */
+    bool HasTileAtIndex(int32 Index) const { return TilePresent.IsValidIndex(Index) && TilePresent[Index]; }
+
+    /** Acteur de la tuile à cet index (nullptr si absente) */
+    AHexTile *GetHexTileAtIndex(int32 Index) const;
+
+    /** Masque 6 bits des voisins présents (bit i = direction GetNeighborDelta(i)) */
+    uint8 GetNeighborMask(int32 Index) const { return NeighborMasks[Index]; }
+
+    /** Type / hauteur (Z monde) d'une tuile par index */
+    EHexTileType GetTileTypeAtIndex(int32 Index) const { return TileTypes[Index]; }
+    float GetTileHeightAtIndex(int32 Index) const { return TileHeights[Index]; }
+
+    /** Coût d'entrée (points de mouvement) d'une tuile par index ; 0 = infranchissable */
+    uint8 GetTileMoveCostAtIndex(int32 Index) const { return TileMoveCosts[Index]; }
+
+    /** Plus petit coût franchissable de la grille (facteur de l'heuristique A*) ; 1 si aucun */
+    int32 GetMinMoveCost() const { return MinMoveCost; }
+
+    // --- Accès par coordonnées, valable dans les deux modes de rendu ---
+
+    /** Une tuile existe à ces coordonnées ? (ne dépend pas d'un acteur) */
+    UFUNCTION(BlueprintPure, Category = "Hex|Query")
+    bool HasTileAt(const FHexAxialCoordinates &Coords) const { return HasTileAtIndex(GetTileIndex(Coords)); }
+
+    /** Position monde de base (sans surélévation de survol) ; false si pas de tuile */
+    UFUNCTION(BlueprintPure, Category = "Hex|Query")
+    bool GetTileWorldLocation(const FHexAxialCoordinates &Coords, FVector &OutLocation) const;
+
+    FVector GetTileWorldLocationAtIndex(int32 Index) const;
+
+    /** Monde -> case : inverse du layout (centre le plus proche parmi 3x3 candidats), O(1).
+     *  OutCoords est toujours rempli ; renvoie true seulement si une tuile existe. */
+    UFUNCTION(BlueprintPure, Category = "Hex|Query")
+    bool WorldToHex(const FVector &WorldLocation, FHexAxialCoordinates &OutCoords) const;
+
+    /** Case sous un rayon (ex. DeprojectMousePositionToWorld) : intersection avec le plan
+     *  de la grille, puis une correction à la hauteur de la tuile trouvée. Pas de trace physique. */
+    bool PickTileFromRay(const FVector &RayOrigin, const FVector &RayDirection, FHexAxialCoordinates &OutCoords) const;
+
+    /** Surbrillance (acteur : SetHighlighted ; instance : custom data surbrillance + élévation) */
+    UFUNCTION(BlueprintCallable, Category = "Hex|Render")
+    void SetTileHighlighted(const FHexAxialCoordinates &Coords, bool bHighlighted);
+
+    /** Visibilité (acteur : caché + collision ; instance : custom data). Ne touche rien si inchangée. */
+    void SetTileVisibleAtIndex(int32 Index, bool bVisible);
+    bool IsTileVisibleAtIndex(int32 Index) const { return TileVisible.IsValidIndex(Index) && TileVisible[Index]; }
+
+    /** Index de tuile d'une instance de la HISM (Hit.Item) ; INDEX_NONE sinon */
+    int32 GetTileIndexFromInstance(int32 InstanceIndex) const;
+
+    UHierarchicalInstancedStaticMeshComponent *GetTileInstances() const { return TileInstances; }
+
+    bool IsInstanced() const { return RenderMode == EHexGridRenderMode::Instanced; }
+
+    /** Version de la grille : incrémentée à chaque rebuild ou changement de type de tuile */
+    uint32 GetGridVersion() const { return GridVersion; }
+
+    /** Copie immuable pour les recherches hors game thread ; recréée seulement si la version a changé */
+    TSharedRef<const FHexGridSnapshot, ESPMode::ThreadSafe> GetSnapshot() const;
+
+    /** Génération en cours (traces de sol asynchrones pas encore revenus) : la grille est vide */
+    bool IsGenerating() const { return bGenerating; }
+    float GetGenerationProgress() const;
+
+    /** Durée de la dernière génération complète (traces + spawn), en secondes */
+    double GetLastGenerationSeconds() const { return LastGenerationSeconds; }
+
+    FOnHexGridGenerationProgress OnGenerationProgress;
+
+    /** Diffusé après chaque changement (rebuild complet ou tuile isolée) */
+    FOnHexGridChanged OnGridChanged;
+
+    /** Type de tuile (Normal si absente) */
+    UFUNCTION(BlueprintPure, Category = "Hex|Query")
+    EHexTileType GetTileType(const FHexAxialCoordinates &Coords) const;
+
+    /** Change le type d'une tuile (données de la grille + visuel de l'acteur) */
+    UFUNCTION(BlueprintCallable, Category = "Hex|Query")
+    void SetTileType(const FHexAxialCoordinates &Coords, EHexTileType NewType);
+
+    /** Coût d'entrée d'une tuile en points de mouvement (0 si absente ou infranchissable) */
+    UFUNCTION(BlueprintPure, Category = "Hex|Movement")
+    int32 GetTileMoveCost(const FHexAxialCoordinates &Coords) const;
+
+    /** Surcharge le coût d'une tuile (0 = infranchissable) ; écrasé quand le type change et au rebuild */
+    UFUNCTION(BlueprintCallable, Category = "Hex|Movement")
+    void SetTileMoveCost(const FHexAxialCoordinates &Coords, int32 NewCost);
+
+    /** Coût d'entrée par type de tuile (type absent : 1, 0 = infranchissable) */
+    UPROPERTY(EditAnywhere, Category = "Hex|Movement", meta = (ClampMin = "0", ClampMax = "255"))
+    TMap<EHexTileType, uint8> MoveCostByType;
+
+    /** Delta voisin (doubled-q) pour la direction Dir ∈ [0,6) : W, NW, NE, E, SE, SW (cf. HexMath) */
+    static FHexAxialCoordinates GetNeighborDelta(int32 Dir) { return FHexAxialCoordinates(HexMath::Direction(Dir)); }
 
     // Cache de voisins calculés en XY (réels)
-    TMap<FHexAxialCoordinates, TArray<FHexAxialCoordinates>> WorldNeighbors;
+    TMap<FHexCoordKey, TArray<FHexAxialCoordinates>> WorldNeighbors;
 
     // Recalcule le cache (à appeler après la génération des tuiles)
     UFUNCTION(BlueprintCallable, Category = "Hex|Grid")
@@ -71,6 +271,7 @@ public:
     UPROPERTY(EditAnywhere, Category = "Hex|Layout", meta = (ClampMin = "0.0"))
     float RowOffsetFactor = 0.5f;
 
+    /** Convention d'offset du layout (odd-q si vrai, sinon odd-r) ; les labels sont toujours doubled-q (cf. HexMath::TGridConvention) */
     UPROPERTY(EditAnywhere, Category = "Hex|Layout")
     bool bOffsetOnQ = true;
 
@@ -91,6 +292,25 @@ public:
     UPROPERTY(EditAnywhere, Category = "Hex|Generation")
     TSubclassOf<AHexTile> HexTileClass;
 
+    /** Actors : un AHexTile par case. Instanced : une HISM, aucune tuile acteur (GetHexTileAt renvoie nullptr) */
+    UPROPERTY(EditAnywhere, Category = "Hex|Render")
+    EHexGridRenderMode RenderMode = EHexGridRenderMode::Actors;
+
+    /** Mesh des instances (mode Instanced) */
+    UPROPERTY(EditAnywhere, Category = "Hex|Render")
+    TObjectPtr<UStaticMesh> InstancedTileMesh;
+
+    /** Matériau des instances ; lit PerInstanceCustomData selon HexInstanceData */
+    UPROPERTY(EditAnywhere, Category = "Hex|Render")
+    TObjectPtr<UMaterialInterface> InstancedTileMaterial;
+
+    UPROPERTY(EditAnywhere, Category = "Hex|Render")
+    FVector InstancedTileScale = FVector::OneVector;
+
+    /** Élévation appliquée à une instance en surbrillance */
+    UPROPERTY(EditAnywhere, Category = "Hex|Render")
+    float InstancedHighlightLiftZ = 10.f;
+
     // Bouton cliquable dans les détails (éditeur & en PIE) pour regénérer
     UFUNCTION(BlueprintCallable, CallInEditor, Category = "Hex|Generation")
     void RebuildGrid();
@@ -111,13 +331,43 @@ public:
     UPROPERTY(EditAnywhere, Category = "Hex|Trace")
     bool bDebugTrace = true;
 
+    /** Traces de sol lancés en lot (AsyncLineTrace*) : RebuildGrid rend la main, OnGridChanged signale la fin.
+     *  Hors monde de jeu (CallInEditor) la génération reste synchrone. */
+    UPROPERTY(EditAnywhere, Category = "Hex|Trace")
+    bool bAsyncGroundTraces = true;
+
+    /** InitializeGrid relit Saved/HexGridCache/<Niveau>.hexgrid (une lecture, aucun trace) tant que la clé
+     *  niveau + paramètres correspond ; sinon génération complète puis réécriture du cache.
+     *  Le cache fige aussi les tirages d'ennemis. */
+    UPROPERTY(EditAnywhere, Category = "Hex|Generation")
+    bool bUseBakedGridCache = true;
+
+    /** Supprime le cache du niveau courant (la prochaine initialisation retrace tout) */
+    UFUNCTION(BlueprintCallable, CallInEditor, Category = "Hex|Generation")
+    void ClearBakedGrid();
+
+#if !UE_BUILD_SHIPPING
+    /** Grille synthétique en mémoire (outillage, Hex.Bench, tests) : hexagone complet de rayon Radius, trous et
+     *  obstacles (coût 0) tirés avec Seed, coûts 1..3 ailleurs, centre toujours praticable.
+     *  Aucun trace ; acteurs et instances existants retirés ; un seul OnGridChanged(INDEX_NONE) à la fin. */
+    void BuildSyntheticGrid(int32 Radius, float HoleChance, float ObstacleChance, int32 Seed);
+#endif
+
     /** Règle d'adjacence: si false, on interdit les voisins axiaux où Q et R changent simultanément (seulement 4 directions) */
     UPROPERTY(EditAnywhere, Category = "Hex|Rules")
     bool bAllowDiagonalAxialNeighbors = true;
 
     
 
+    /** Pousse les custom data modifiées vers le rendu (une fois par frame) */
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
+
 private:
+    /** Position XY du layout pour les indices de génération (Col,Row), sans trace */
+    FVector2D ComputeTileXY(int32 Q, int32 R) const;
+    /** Pas et décalages du placement monde (ComputeTileXY / WorldToHex) */
+    HexMath::FLayout GetWorldLayout() const;
+
     /** Calcule la position finale (X,Y,Z) d’une tuile (Q,R) :
      *  - XY selon le layout (XSpacingFactor/YSpacingFactor + offset demi-ligne configurable)
      *  - Z par line trace (ECC_Visibility) + fallback Static/Dynamic + TileZOffset
@@ -126,19 +376,46 @@ private:
 
     bool TryComputeTileSpawnPosition(int32 Q, int32 R, FVector &OutLocation) const;
 
-    /** Remap des indices génération -> coordonnées axiales attribuées (n'affecte pas la position monde) */
-    UPROPERTY(EditAnywhere, Category = "Hex|Coordinates")
-    bool bInvertRAxisForLabels = false;
-
-    UPROPERTY(EditAnywhere, Category = "Hex|Coordinates")
-    bool bInvertQAxisForLabels = false;
-
-    UPROPERTY(EditAnywhere, Category = "Hex|Coordinates")
-    bool bSwapQRForLabels = false;
-
-    /** Utiliser un repère "doubled-q" pour les coordonnées attribuées (voisins: (±2,0), (±1,±1)) */
-    UPROPERTY(EditAnywhere, Category = "Hex|Coordinates")
-    bool bUseDoubledQForLabels = false;
+    /** Filtre Floor + TileZOffset, commun aux traces synchrones et asynchrones */
+    bool AcceptGroundHit(int32 Q, int32 R, const FHitResult &Hit, float &OutZ) const;
+
+    // --- Génération : traces de sol en lot ---
+
+    /** Case en attente de son trace de sol */
+    struct FGroundTraceCell
+    {
+        int32 Col;
+        int32 Row;
+        float Z;
+        bool bHit;      // un hit bloquant (pas de passage objets)
+        bool bAccepted; // hit retenu : une tuile sera créée
+    };
+
+    /** Lance un trace par case (passage canal, ou passage objets pour les cases sans hit) */
+    void IssueGroundTraces(bool bObjectPass);
+    void OnGroundTraceDone(const FTraceHandle &Handle, FTraceDatum &Datum, uint32 Serial, bool bObjectPass);
+
+    /** Spawn/instances en bloc, voisins, cases spéciales, puis OnGridChanged.
+     *  bFromBake : types et masques déjà chargés, pas de tirage ni de recalcul */
+    void FinishRebuildGrid(bool bFromBake);
+    void CancelGeneration();
+
+    // --- Cache de grille cuite ---
+    FString GetBakedGridPath() const;
+    /** GridOrigin, ou la position du propriétaire si elle est nulle ; même valeur pour la clé, le chargement et le rebuild */
+    FVector GetEffectiveGridOrigin() const;
+    uint32 ComputeBakeKey() const;
+    bool LoadBakedGrid();
+    void SaveBakedGrid() const;
+
+    TArray<FGroundTraceCell> GroundCells;
+    int32 GroundTracesInFlight = 0;
+    int32 GroundTracesDone = 0;
+    int32 GroundTracesTotal = 0;
+    uint32 GenerationSerial = 0;
+    bool bGenerating = false;
+    double GenerationStartSeconds = 0.0;
+    double LastGenerationSeconds = 0.0;
 
     UPROPERTY(EditAnywhere, Category = "Hex|Data")
     TArray<FHexAxialCoordinates> ShopTiles; // coords en doubled-Q
@@ -159,15 +436,74 @@ private:
 
     FRandomStream EnemyRng;
 
+    /** Labels -> indices de génération (Col,Row), inverse de MapSpawnIndexToAxial */
+    bool AxialToSpawnIndex(const FHexAxialCoordinates &Coords, int32 &OutCol, int32 &OutRow) const;
+    static bool AxialToSpawnIndex(const FHexAxialCoordinates &Coords, bool bInOffsetOnQ, int32 &OutCol, int32 &OutRow);
+
+    /** Alloue le stockage dense pour un hexagone de rayon Radius (INDEX_NONE = vide) */
+    void ResetTileStorage(int32 Radius);
+
+    /** Recalcule les masques de voisins de toutes les tuiles */
+    void RebuildNeighborMasks();
+
+    /** Coût par défaut d'un type (MoveCostByType, 1 si absent) */
+    uint8 GetDefaultMoveCost(EHexTileType Type) const;
+
+    /** Coûts de toutes les tuiles depuis leur type, puis MinMoveCost */
+    void RebuildMoveCosts();
+    void RecomputeMinMoveCost();
+
+    /** Tient MinMoveCost à jour après le changement de coût d'une tuile ; ne rescanne que si le minimum perd sa dernière tuile */
+    void UpdateMinMoveCost(uint8 OldCost, uint8 NewCost);
+
+    /** Incrémente la version et diffuse OnGridChanged (muet pendant un rebuild) */
+    void NotifyGridChanged(int32 TileIndex);
+
+    uint32 GridVersion = 0;
+    bool bRebuildingGrid = false;
+
+    /** Dernier snapshot donné (partagé tant que la version ne bouge pas) */
+    mutable TSharedPtr<const FHexGridSnapshot, ESPMode::ThreadSafe> CachedSnapshot;
+
+    int32 MinMoveCost = 1;
+    /** Tuiles présentes au coût MinMoveCost (0 : aucune tuile praticable, MinMoveCost vaut 1 par défaut) */
+    int32 MinMoveCostTiles = 0;
+
+    /** Rayon de l'hexagone actuellement indexé (GridRadius peut changer sans rebuild) */
+    int32 IndexedRadius = INDEX_NONE;
+
+    // --- Stockage dense (structure of arrays), indexé par GetTileIndex ---
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<AHexTile>> TileActors;
+
+    TArray<FHexAxialCoordinates> TileCoords;
+    TArray<EHexTileType> TileTypes;
+    TArray<float> TileHeights;
+    TArray<uint8> NeighborMasks;
+    TArray<uint8> TileMoveCosts; // 0 = infranchissable
+    TBitArray<> TilePresent;
+    TBitArray<> TileVisible;
+
+    // --- Mode Instanced ---
+    UPROPERTY(Transient)
+    TObjectPtr<UHierarchicalInstancedStaticMeshComponent> TileInstances;
+
+    TArray<int32> TileInstanceIds;     // index tuile -> instance
+    TArray<int32> InstanceTileIndices; // instance -> index tuile
+    bool bInstanceDataDirty = false;
+
+    /** Crée/prépare la HISM et la vide */
+    void ResetTileInstances();
+
+    /** Écrit une custom data et programme le MarkRenderStateDirty groupé */
+    void SetInstanceData(int32 Index, int32 Slot, float Value);
+
 public:
     /** Distance entre A et B selon la convention courante (doubled-q ou non) */
     UFUNCTION(BlueprintPure, Category = "Hex|Query")
     int32 AxialDistance(const FHexAxialCoordinates &A, const FHexAxialCoordinates &B) const;
 
-    /** Map interne Q,R → Actor de tuile */
-    UPROPERTY()
-    TMap<FHexAxialCoordinates, TWeakObjectPtr<AHexTile>> TilesMap;
-    
+
     virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void BeginDestroy() override;
 };
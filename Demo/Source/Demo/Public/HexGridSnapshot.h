@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HexCoordinates.h"
+#include "HexGridManager.h"
+
+/**
+ * Copie immuable du graphe de la grille (index dense, voisins, types) à un instant donné.
+ * Partagée en lecture seule entre le game thread et les workers (TSharedRef thread-safe) :
+ * aucun UObject, aucune référence vers UHexGridManager.
+ */
+struct DEMO_API FHexGridSnapshot
+{
+	/** Version de la grille capturée (UHexGridManager::GetGridVersion) */
+	uint32 Version = 0;
+
+	/** Rayon indexé et convention d'offset : suffisent à GetTileIndex en forme close */
+	int32 Radius = INDEX_NONE;
+	bool  bOffsetOnQ = true;
+
+	TArray<FHexAxialCoordinates> TileCoords;
+	TArray<EHexTileType>         TileTypes;
+	TArray<uint8>                NeighborMasks;
+	TArray<uint8>                MoveCosts;   // 0 = infranchissable
+	int32                        MinMoveCost = 1;
+	TBitArray<>                  TilePresent;
+
+	int32 Num() const { return TileCoords.Num(); }
+
+	int32 GetTileIndex(const FHexAxialCoordinates& Coords) const
+	{
+		return UHexGridManager::ComputeTileIndex(Coords, Radius, bOffsetOnQ);
+	}
+
+	bool HasTileAtIndex(int32 Index) const { return TilePresent.IsValidIndex(Index) && TilePresent[Index]; }
+
+	/** Fn(IndexVoisin, Direction) pour chaque voisin existant */
+	template <typename FuncType>
+	void ForEachNeighborIndex(int32 Index, FuncType&& Fn) const
+	{
+		WithTileIndexer([&](const auto& Indexer) { ForEachNeighborIndex(Indexer, Index, Fn); });
+	}
+
+	/** Variante des boucles chaudes : convention résolue à la compilation (cf. UHexGridManager::WithTileIndexer) */
+	template <typename TConvention, typename FuncType>
+	void ForEachNeighborIndex(const HexMath::TTileIndexer<TConvention>& Indexer, int32 Index, FuncType&& Fn) const
+	{
+		const HexMath::FCoord C = TileCoords[Index].ToHexMath();
+		for (uint32 Mask = NeighborMasks[Index]; Mask; Mask &= Mask - 1)
+		{
+			const int32 Dir = FMath::CountTrailingZeros(Mask);
+			Fn(Indexer.NeighborIndexOf(C, Dir), Dir);
+		}
+	}
+
+	/** Fn(TTileIndexer<Convention>) avec la convention capturée */
+	template <typename FuncType>
+	decltype(auto) WithTileIndexer(FuncType&& Fn) const
+	{
+		return HexMath::DispatchConvention(bOffsetOnQ, Radius, Forward<FuncType>(Fn));
+	}
+};
+
+using FHexGridSnapshotRef = TSharedRef<const FHexGridSnapshot, ESPMode::ThreadSafe>;
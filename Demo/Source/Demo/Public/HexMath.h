@@ -0,0 +1,493 @@
+#pragma once
+
+// Maths hex pures : C++ standard uniquement (ni UObject ni CoreMinimal), constexpr et sans allocation.
+// Compilable hors moteur : tests à la compilation et banc dans Private/HexMathTests.cpp.
+#include <cstdint>
+
+/**
+ * Coordonnées "labels" du projet : doubled-q (Q = 2 * q axial, toujours pair), R = r axial.
+ * Tout ce qui touche aux voisins, distances, anneaux, lignes, rotations et au passage offset/monde vit ici ;
+ * la grille, le pathfinder et le game mode s'appuient dessus au lieu de garder leur propre copie.
+ *
+ * La convention d'offset (colonnes ou lignes décalées) est un paramètre de template : FOddQ / FOddR.
+ */
+namespace HexMath
+{
+	using int16 = std::int16_t;
+	using int32 = std::int32_t;
+	using uint16 = std::uint16_t;
+	using uint32 = std::uint32_t;
+
+	struct FCoord
+	{
+		int32 Q = 0;
+		int32 R = 0;
+
+		constexpr bool operator==(const FCoord& O) const { return Q == O.Q && R == O.R; }
+		constexpr bool operator!=(const FCoord& O) const { return !(*this == O); }
+		constexpr FCoord operator+(const FCoord& O) const { return FCoord{Q + O.Q, R + O.R}; }
+		constexpr FCoord operator-(const FCoord& O) const { return FCoord{Q - O.Q, R - O.R}; }
+		constexpr FCoord operator*(int32 K) const { return FCoord{Q * K, R * K}; }
+	};
+
+	struct FOffset
+	{
+		int32 Col = 0;
+		int32 Row = 0;
+
+		constexpr bool operator==(const FOffset& O) const { return Col == O.Col && Row == O.Row; }
+	};
+
+	struct FVec2
+	{
+		float X = 0.f;
+		float Y = 0.f;
+	};
+
+	// ---------------------------------------------------------------- Scalaires
+
+	constexpr int32 Abs(int32 X) { return X < 0 ? -X : X; }
+	constexpr int32 Max(int32 A, int32 B) { return A < B ? B : A; }
+
+	/** floor(X / 2) pour entiers signés */
+	constexpr int32 FloorDiv2(int32 X) { return (X >= 0) ? (X >> 1) : -((-X + 1) >> 1); }
+
+	constexpr int32 FloorToInt(double X)
+	{
+		const int32 T = static_cast<int32>(X);
+		return (X < static_cast<double>(T)) ? T - 1 : T;
+	}
+
+	/** Arrondi au plus proche, demi vers +inf (comme FMath::RoundToInt32) */
+	constexpr int32 RoundToInt(double X) { return FloorToInt(X + 0.5); }
+
+	// ---------------------------------------------------------------- Directions
+
+	/** Deltas voisins en doubled-q : W, NW, NE, E, SE, SW (direction opposée = (Dir + 3) % 6) */
+	constexpr int32 NeighborDQ[6] = {-2, -2, 0, +2, +2, 0};
+	constexpr int32 NeighborDR[6] = {0, +1, +1, 0, -1, -1};
+
+	constexpr int32 NumDirections = 6;
+
+	constexpr int32 OppositeDir(int32 Dir) { return (Dir + 3) % 6; }
+	constexpr FCoord Direction(int32 Dir) { return FCoord{NeighborDQ[Dir], NeighborDR[Dir]}; }
+	constexpr FCoord Neighbor(const FCoord& C, int32 Dir) { return FCoord{C.Q + NeighborDQ[Dir], C.R + NeighborDR[Dir]}; }
+
+	/** Direction A -> B si B est voisin de A, sinon -1 */
+	constexpr int32 DirectionTo(const FCoord& A, const FCoord& B)
+	{
+		for (int32 Dir = 0; Dir < 6; ++Dir)
+			if (B.Q - A.Q == NeighborDQ[Dir] && B.R - A.R == NeighborDR[Dir])
+				return Dir;
+		return -1;
+	}
+
+	constexpr bool AreNeighbors(const FCoord& A, const FCoord& B) { return DirectionTo(A, B) >= 0; }
+
+	/** Label valide : Q pair */
+	constexpr bool IsValid(const FCoord& C) { return (C.Q & 1) == 0; }
+
+	// ---------------------------------------------------------------- Distance
+
+	/** Distance hex entre deux labels doubled-q (q axial = Q / 2) */
+	constexpr int32 Distance(const FCoord& A, const FCoord& B)
+	{
+		const int32 dq = (A.Q - B.Q) / 2;
+		const int32 dr = A.R - B.R;
+		return (Abs(dq) + Abs(dr) + Abs(dq + dr)) / 2;
+	}
+
+	// ---------------------------------------------------------------- Rotation
+
+	/** Rotation de 60° autour de l'origine : Direction(d) -> Direction(d + 1) */
+	constexpr FCoord Rotate60(const FCoord& C)
+	{
+		const int32 q = C.Q / 2;
+		return FCoord{(q + C.R) * 2, -q};
+	}
+
+	/** Steps crans de 60° autour de Center (négatif : sens inverse) */
+	constexpr FCoord Rotate(const FCoord& C, const FCoord& Center, int32 Steps)
+	{
+		Steps = ((Steps % 6) + 6) % 6;
+		FCoord D = C - Center;
+		for (int32 i = 0; i < Steps; ++i)
+			D = Rotate60(D);
+		return Center + D;
+	}
+
+	// ---------------------------------------------------------------- Anneaux et spirales
+
+	constexpr int32 RingSize(int32 Radius) { return Radius <= 0 ? 1 : 6 * Radius; }
+	constexpr int32 SpiralSize(int32 Radius) { return Radius < 0 ? 0 : 3 * Radius * (Radius + 1) + 1; }
+
+	/**
+	 * I-ème case de l'anneau (I ∈ [0, RingSize)). Part du coin Direction(1) * Radius puis tourne :
+	 * deux cases consécutives (et la dernière avec la première) sont voisines.
+	 */
+	constexpr FCoord RingAt(const FCoord& Center, int32 Radius, int32 I)
+	{
+		if (Radius <= 0)
+			return Center;
+		const int32 Side = I / Radius;
+		const int32 Step = I % Radius;
+		return Center + Direction((1 + Side) % 6) * Radius + Direction((3 + Side) % 6) * Step;
+	}
+
+	/** I-ème case de la spirale (centre, puis anneaux 1..Radius) */
+	constexpr FCoord SpiralAt(const FCoord& Center, int32 I)
+	{
+		if (I <= 0)
+			return Center;
+		int32 Ring = 1;
+		while (SpiralSize(Ring) <= I)
+			++Ring;
+		return RingAt(Center, Ring, I - SpiralSize(Ring - 1));
+	}
+
+	template <typename FuncType>
+	constexpr void ForEachInRing(const FCoord& Center, int32 Radius, FuncType&& Fn)
+	{
+		if (Radius <= 0)
+		{
+			Fn(Center);
+			return;
+		}
+		FCoord C = Center + Direction(1) * Radius;
+		for (int32 Side = 0; Side < 6; ++Side)
+		{
+			for (int32 Step = 0; Step < Radius; ++Step)
+			{
+				Fn(C);
+				C = Neighbor(C, (3 + Side) % 6);
+			}
+		}
+	}
+
+	template <typename FuncType>
+	constexpr void ForEachInSpiral(const FCoord& Center, int32 Radius, FuncType&& Fn)
+	{
+		for (int32 Ring = 0; Ring <= Radius; ++Ring)
+			ForEachInRing(Center, Ring, Fn);
+	}
+
+	// ---------------------------------------------------------------- Lignes
+
+	/** Cube arrondi (x + y + z = 0) vers le label doubled-q le plus proche */
+	constexpr FCoord CubeRound(double X, double Y, double Z)
+	{
+		int32 RX = RoundToInt(X), RY = RoundToInt(Y), RZ = RoundToInt(Z);
+		const double DX = X - RX < 0 ? RX - X : X - RX;
+		const double DY = Y - RY < 0 ? RY - Y : Y - RY;
+		const double DZ = Z - RZ < 0 ? RZ - Z : Z - RZ;
+		if (DX > DY && DX > DZ)
+			RX = -RY - RZ;
+		else if (DY > DZ)
+			RY = -RX - RZ;
+		return FCoord{RX * 2, RY};
+	}
+
+	/** I-ème case (I ∈ [0, Distance]) de la ligne A -> B ; nudge pour départager les cas sur l'arête */
+	constexpr FCoord LineAt(const FCoord& A, const FCoord& B, int32 I)
+	{
+		const int32 N = Distance(A, B);
+		if (N == 0)
+			return A;
+		const double T = static_cast<double>(I) / N;
+		const double AX = A.Q / 2 + 1e-6, AY = A.R + 1e-6, AZ = -(A.Q / 2) - A.R - 2e-6;
+		const double BX = B.Q / 2 + 1e-6, BY = B.R + 1e-6, BZ = -(B.Q / 2) - B.R - 2e-6;
+		return CubeRound(AX + (BX - AX) * T, AY + (BY - AY) * T, AZ + (BZ - AZ) * T);
+	}
+
+	/** Fn(Case) pour Distance(A, B) + 1 cases, A et B inclus, chaque pas adjacent au précédent */
+	template <typename FuncType>
+	constexpr void ForEachOnLine(const FCoord& A, const FCoord& B, FuncType&& Fn)
+	{
+		const int32 N = Distance(A, B);
+		for (int32 I = 0; I <= N; ++I)
+			Fn(LineAt(A, B, I));
+	}
+
+	// ---------------------------------------------------------------- Conventions d'offset
+
+	/** Colonnes décalées (odd-q) : axial q = Col, r = Row - floor(Col / 2) */
+	struct FOddQ
+	{
+		static constexpr bool bOffsetOnQ = true;
+
+		static constexpr FCoord ToDoubled(const FOffset& O) { return FCoord{O.Col * 2, O.Row - FloorDiv2(O.Col)}; }
+		static constexpr FOffset FromDoubled(const FCoord& C)
+		{
+			const int32 q = C.Q >> 1;
+			return FOffset{q, C.R + FloorDiv2(q)};
+		}
+		static constexpr bool IsShifted(const FOffset& O) { return (O.Col & 1) != 0; }
+	};
+
+	/** Lignes décalées (odd-r) : axial q = Col - floor(Row / 2), r = Row */
+	struct FOddR
+	{
+		static constexpr bool bOffsetOnQ = false;
+
+		static constexpr FCoord ToDoubled(const FOffset& O) { return FCoord{(O.Col - FloorDiv2(O.Row)) * 2, O.Row}; }
+		static constexpr FOffset FromDoubled(const FCoord& C)
+		{
+			const int32 q = C.Q >> 1;
+			return FOffset{q + FloorDiv2(C.R), C.R};
+		}
+		static constexpr bool IsShifted(const FOffset& O) { return (O.Row & 1) != 0; }
+	};
+
+	/** Seules FOddQ / FOddR sont des conventions d'offset : toute autre type est refusé à la compilation */
+	template <typename T> struct TIsOffsetConvention { static constexpr bool Value = false; };
+	template <> struct TIsOffsetConvention<FOddQ> { static constexpr bool Value = true; };
+	template <> struct TIsOffsetConvention<FOddR> { static constexpr bool Value = true; };
+
+	/** Aiguillage runtime -> template, pour les appelants qui n'ont qu'un bool (réglage d'éditeur) */
+	template <typename FuncType>
+	constexpr decltype(auto) DispatchOffset(bool bOffsetOnQ, FuncType&& Fn)
+	{
+		return bOffsetOnQ ? Fn(FOddQ{}) : Fn(FOddR{});
+	}
+
+	template <typename TOffset>
+	constexpr FCoord OffsetToDoubled(int32 Col, int32 Row)
+	{
+		static_assert(TIsOffsetConvention<TOffset>::Value, "OffsetToDoubled : FOddQ ou FOddR attendu");
+		return TOffset::ToDoubled(FOffset{Col, Row});
+	}
+
+	/** False si le label n'est pas doubled-q (Q impair) */
+	template <typename TOffset>
+	constexpr bool DoubledToOffset(const FCoord& C, FOffset& Out)
+	{
+		static_assert(TIsOffsetConvention<TOffset>::Value, "DoubledToOffset : FOddQ ou FOddR attendu");
+		if (!IsValid(C))
+			return false;
+		Out = TOffset::FromDoubled(C);
+		return true;
+	}
+
+	// ---------------------------------------------------------------- Monde <-> hex
+
+	/**
+	 * Layout du placement monde : pas en X par colonne, pas en Y par ligne, décalage Y des colonnes
+	 * (odd-q) ou lignes (odd-r) impaires. Origin inclut les nudges éventuels.
+	 */
+	struct FLayout
+	{
+		float StepX = 0.f;
+		float StepY = 0.f;
+		float Shift = 0.f;
+		FVec2 Origin;
+	};
+
+	template <typename TOffset>
+	constexpr FVec2 OffsetToWorld(const FLayout& L, const FOffset& O)
+	{
+		static_assert(TIsOffsetConvention<TOffset>::Value, "OffsetToWorld : FOddQ ou FOddR attendu");
+		const float RowShift = TOffset::IsShifted(O) ? L.Shift : 0.f;
+		return FVec2{L.Origin.X + O.Col * L.StepX, L.Origin.Y + O.Row * L.StepY + RowShift};
+	}
+
+	template <typename TOffset>
+	constexpr FVec2 HexToWorld(const FLayout& L, const FCoord& C)
+	{
+		return OffsetToWorld<TOffset>(L, TOffset::FromDoubled(C));
+	}
+
+	/**
+	 * Centre le plus proche de P : estimation directe puis voisinage 3x3 (cellules de Voronoï des centres),
+	 * exact quels que soient les pas et le décalage. False si le layout est dégénéré.
+	 */
+	template <typename TOffset>
+	constexpr bool WorldToOffset(const FLayout& L, const FVec2& P, FOffset& Out)
+	{
+		static_assert(TIsOffsetConvention<TOffset>::Value, "WorldToOffset : FOddQ ou FOddR attendu");
+		const float AbsX = L.StepX < 0.f ? -L.StepX : L.StepX;
+		const float AbsY = L.StepY < 0.f ? -L.StepY : L.StepY;
+		if (AbsX < 1e-8f || AbsY < 1e-8f)
+			return false;
+
+		const float LocalX = P.X - L.Origin.X;
+		const float LocalY = P.Y - L.Origin.Y;
+		const int32 Col0 = RoundToInt(LocalX / L.StepX);
+		const int32 Row0 = RoundToInt((LocalY - (TOffset::bOffsetOnQ ? 0.f : L.Shift * 0.5f)) / L.StepY);
+
+		float BestD2 = 3.4e38f;
+		for (int32 Col = Col0 - 1; Col <= Col0 + 1; ++Col)
+		{
+			// En odd-q le décalage dépend de la colonne : on le retire avant d'estimer la ligne
+			const int32 RowBase = TOffset::bOffsetOnQ
+				? RoundToInt((LocalY - ((Col & 1) ? L.Shift : 0.f)) / L.StepY)
+				: Row0;
+
+			for (int32 Row = RowBase - 1; Row <= RowBase + 1; ++Row)
+			{
+				const FVec2 C = OffsetToWorld<TOffset>(L, FOffset{Col, Row});
+				const float DX = C.X - P.X;
+				const float DY = C.Y - P.Y;
+				const float D2 = DX * DX + DY * DY;
+				if (D2 < BestD2)
+				{
+					BestD2 = D2;
+					Out = FOffset{Col, Row};
+				}
+			}
+		}
+		return true;
+	}
+
+	template <typename TOffset>
+	constexpr bool WorldToHex(const FLayout& L, const FVec2& P, FCoord& Out)
+	{
+		FOffset O;
+		if (!WorldToOffset<TOffset>(L, P, O))
+			return false;
+		Out = TOffset::ToDoubled(O);
+		return true;
+	}
+
+	// ---------------------------------------------------------------- Convention de grille
+
+	/**
+	 * Politique de coordonnées d'une grille hexagonale bornée : labels doubled-q + convention d'offset.
+	 * Voisins, distance et index dense sont résolus à la compilation ; les boucles chaudes sont
+	 * instanciées une fois par convention (cf. DispatchConvention) au lieu de tester un bool par voisin.
+	 */
+	template <typename TOffset>
+	struct TGridConvention
+	{
+		static_assert(TIsOffsetConvention<TOffset>::Value, "TGridConvention : FOddQ ou FOddR attendu");
+
+		using FOffsetConvention = TOffset;
+		static constexpr bool bOffsetOnQ = TOffset::bOffsetOnQ;
+
+		static constexpr FCoord Neighbor(const FCoord& C, int32 Dir) { return HexMath::Neighbor(C, Dir); }
+		static constexpr int32 Distance(const FCoord& A, const FCoord& B) { return HexMath::Distance(A, B); }
+
+		/** Nombre de cases de l'hexagone (Col,Row) de rayon Radius */
+		static constexpr int32 TileCount(int32 Radius) { return SpiralSize(Radius); }
+
+		/** Index dense en forme close dans l'hexagone (Col,Row) de rayon Radius ; -1 hors grille ou label invalide */
+		static constexpr int32 TileIndex(const FCoord& C, int32 Radius)
+		{
+			if (!IsValid(C))
+				return -1;
+			const FOffset O = TOffset::FromDoubled(C);
+			const int32 Col = O.Col;
+			const int32 Row = O.Row;
+
+			// Hexagone (Col,Row) de rayon N : |Col| <= N, |Row| <= N, |Col+Row| <= N
+			const int32 N = Radius;
+			if (Abs(Col) > N || Abs(Row) > N || Abs(Col + Row) > N)
+				return -1;
+
+			// Début de la colonne Col (colonnes de longueur 2N+1-|c|, rangées de -N à Col-1)
+			int32 ColumnStart = 0;
+			if (Col <= 0)
+			{
+				const int32 K = Col + N;
+				ColumnStart = K * (N + 1) + K * (K - 1) / 2;
+			}
+			else
+			{
+				ColumnStart = (3 * N * N + N) / 2 + Col * (2 * N + 1) - Col * (Col - 1) / 2;
+			}
+
+			const int32 RowMin = Max(-N, -Col - N);
+			return ColumnStart + (Row - RowMin);
+		}
+	};
+
+	using FOddQGrid = TGridConvention<FOddQ>;
+	using FOddRGrid = TGridConvention<FOddR>;
+
+	template <typename T> struct TIsGridConvention { static constexpr bool Value = false; };
+	template <typename TOffset> struct TIsGridConvention<TGridConvention<TOffset>> { static constexpr bool Value = true; };
+
+	namespace Detail { struct FTileIndexerAccess; }
+
+	/**
+	 * Index dense d'une grille de rayon donné, typé par sa convention : un indexeur odd-q ne se convertit
+	 * pas en indexeur odd-r, et ne s'obtient qu'auprès de la grille (ou du snapshot) qui a cette convention.
+	 * Constructeur privé : seul DispatchConvention en fabrique, à partir du réglage de la grille.
+	 */
+	template <typename TConvention>
+	class TTileIndexer
+	{
+		static_assert(TIsGridConvention<TConvention>::Value, "TTileIndexer : FOddQGrid ou FOddRGrid attendu");
+
+	public:
+		using FConvention = TConvention;
+
+		constexpr int32 IndexOf(const FCoord& C) const { return TConvention::TileIndex(C, Radius); }
+		constexpr int32 NeighborIndexOf(const FCoord& C, int32 Dir) const { return TConvention::TileIndex(TConvention::Neighbor(C, Dir), Radius); }
+
+	private:
+		friend struct Detail::FTileIndexerAccess;
+		constexpr explicit TTileIndexer(int32 InRadius) : Radius(InRadius) {}
+
+		int32 Radius;
+	};
+
+	namespace Detail
+	{
+		struct FTileIndexerAccess
+		{
+			template <typename TConvention>
+			static constexpr TTileIndexer<TConvention> Make(int32 Radius) { return TTileIndexer<TConvention>(Radius); }
+		};
+	}
+
+	/** Choix runtime (réglage d'éditeur) -> Fn(TTileIndexer<Convention>), une instanciation par convention */
+	template <typename FuncType>
+	constexpr decltype(auto) DispatchConvention(bool bOffsetOnQ, int32 Radius, FuncType&& Fn)
+	{
+		return bOffsetOnQ ? Fn(Detail::FTileIndexerAccess::Make<FOddQGrid>(Radius))
+		                  : Fn(Detail::FTileIndexerAccess::Make<FOddRGrid>(Radius));
+	}
+
+	// ---------------------------------------------------------------- Clé compacte
+
+	/**
+	 * Label doubled-q tassé sur 32 bits : q axial (Q / 2) en bas, R en haut, deux int16.
+	 * Couvre toute grille de rayon < 32768 ; Q impair n'est pas représentable (label invalide).
+	 */
+	struct FPackedKey
+	{
+		uint32 Bits = 0;
+
+		static constexpr bool CanPack(const FCoord& C)
+		{
+			const int32 q = C.Q >> 1;
+			return IsValid(C) && q >= -32768 && q <= 32767 && C.R >= -32768 && C.R <= 32767;
+		}
+
+		static constexpr FPackedKey Pack(const FCoord& C)
+		{
+			return FPackedKey{uint32(uint16(int16(C.Q >> 1))) | (uint32(uint16(int16(C.R))) << 16)};
+		}
+
+		constexpr FCoord Unpack() const
+		{
+			return FCoord{int32(int16(uint16(Bits & 0xFFFFu))) * 2, int32(int16(uint16(Bits >> 16)))};
+		}
+
+		/** Un multiply-add : les bits bas (ceux que garde la table) mélangent q et r */
+		constexpr uint32 Hash() const { return (Bits & 0xFFFFu) + (Bits >> 16) * 0x9E3779B1u; }
+
+		/** Hash parfait d'une grille bornée : index dense dans [0, TileCount), -1 hors grille */
+		template <typename TConvention>
+		constexpr int32 TileIndex(int32 Radius) const
+		{
+			static_assert(TIsGridConvention<TConvention>::Value, "FPackedKey::TileIndex : FOddQGrid ou FOddRGrid attendu");
+			return TConvention::TileIndex(Unpack(), Radius);
+		}
+
+		constexpr bool operator==(const FPackedKey& O) const { return Bits == O.Bits; }
+		constexpr bool operator!=(const FPackedKey& O) const { return Bits != O.Bits; }
+	};
+
+	static_assert(sizeof(FPackedKey) == sizeof(uint32), "FPackedKey : 32 bits");
+}
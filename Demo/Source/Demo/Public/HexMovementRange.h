@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HexCoordinates.h"
+#include "HexPathFinder.h"
+
+/**
+ * Règles d'une requête de portée (UHexPathFinder::ComputeMovementRange).
+ * Profile fixe le budget de points de mouvement (<= 0 : illimité) et les types interdits.
+ */
+struct DEMO_API FHexRangeRules
+{
+	FHexPathCostProfile Profile;
+
+	/** Zone de contrôle, un bit par index dense : on peut y entrer, mais le mouvement s'y arrête (vide : aucune) */
+	TBitArray<> ZoneOfControl;
+
+	/** Cases occupées, un bit par index dense : infranchissables pour cette requête (vide : aucune) */
+	TBitArray<> Blocked;
+
+	/** Garde coût et parent par case (chemins, validation) ; sinon seul le bitset est rempli, sans tableau par case alloué */
+	bool bKeepCosts = true;
+
+	bool IsZoneOfControl(int32 Index) const { return ZoneOfControl.IsValidIndex(Index) && ZoneOfControl[Index]; }
+	bool IsBlocked(int32 Index) const { return Blocked.IsValidIndex(Index) && Blocked[Index]; }
+};
+
+/**
+ * Cases atteignables depuis une origine avec un budget : un bit par index dense, plus (optionnel) le coût
+ * minimal et le parent sur le plus court chemin. Un seul calcul sert la visibilité, la surbrillance et la
+ * validation serveur des déplacements tant que la grille (GridVersion) n'a pas bougé.
+ */
+struct DEMO_API FHexMovementRange
+{
+	int32  OriginIndex = INDEX_NONE;
+	uint32 GridVersion = 0;
+	FHexRangeRules Rules;
+
+	TBitArray<>   Reachable;    // origine incluse
+	TArray<int32> CostToReach;  // INDEX_NONE = hors portée ; vide si !Rules.bKeepCosts
+	TArray<int32> Parents;      // INDEX_NONE = origine ou hors portée ; vide si !Rules.bKeepCosts
+
+	bool IsValid() const { return OriginIndex != INDEX_NONE; }
+	int32 GetBudget() const { return Rules.Profile.MovementBudget; }
+	int32 Num() const { return Reachable.CountSetBits(); }
+
+	bool Contains(int32 Index) const { return Reachable.IsValidIndex(Index) && Reachable[Index]; }
+
+	/** Coût minimal jusqu'à Index ; INDEX_NONE hors portée ou coûts non gardés */
+	int32 GetCost(int32 Index) const { return CostToReach.IsValidIndex(Index) ? CostToReach[Index] : INDEX_NONE; }
+
+	/** Plus court chemin origine -> Index (origine incluse) ; false hors portée ou coûts non gardés */
+	bool GetPathTo(const UHexGridManager& Grid, int32 Index, TArray<FHexAxialCoordinates>& OutPath) const
+	{
+		OutPath.Reset();
+		if (!Contains(Index) || !Parents.IsValidIndex(Index))
+			return false;
+
+		int32 Len = 0;
+		for (int32 I = Index; I != INDEX_NONE; I = Parents[I])
+			++Len;
+		OutPath.SetNumUninitialized(Len);
+		for (int32 k = Len - 1, I = Index; k >= 0; --k, I = Parents[I])
+			OutPath[k] = Grid.GetTileCoords(I);
+		return true;
+	}
+};
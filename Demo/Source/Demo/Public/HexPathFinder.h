@@ -3,11 +3,90 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "HexCoordinates.h"
+#include "HexTile.h"
+#include "HexCooperativePlanner.h"
+#include <atomic>
 #include "HexPathFinder.generated.h"
 
 class UHexGridManager;
+struct FHexGridSnapshot;
+struct FHexFlowField;
+struct FHexRangeRules;
+struct FHexMovementRange;
+class FHexClusterGraph;
 
-/** A* sur grille hex (doubled-q), voisins = tuiles réellement présentes. */
+/**
+ * Règles d'une requête de chemin. Le coût d'entrée d'une tuile vient de la grille
+ * (UHexGridManager::GetTileMoveCostAtIndex) ; le profil ne fait que le restreindre.
+ */
+struct DEMO_API FHexPathCostProfile
+{
+	/** Points de mouvement du tour : le chemin renvoyé s'arrête à la dernière tuile payable ; <= 0 : chemin complet */
+	int32 MovementBudget = 6;
+
+	/** Coût 1 partout (sauf tuiles infranchissables) */
+	bool bIgnoreTerrain = false;
+
+	/** Types interdits pour cette requête, un bit par EHexTileType */
+	uint8 ImpassableTypeMask = 0;
+
+	void SetTypeImpassable(EHexTileType Type) { ImpassableTypeMask |= uint8(1u << uint8(Type)); }
+
+	/** Seul le budget change le résultat : partage le cache de FindPath */
+	bool UsesGridCostsOnly() const { return !bIgnoreTerrain && ImpassableTypeMask == 0; }
+
+	/** Coût d'entrée effectif ; 0 = infranchissable */
+	uint8 GetStepCost(EHexTileType Type, uint8 TerrainCost) const
+	{
+		if (TerrainCost == 0 || (ImpassableTypeMask & (1u << uint8(Type))))
+			return 0;
+		return bIgnoreTerrain ? 1 : TerrainCost;
+	}
+};
+
+/** Résultat d'une requête asynchrone (livré sur le game thread) */
+struct DEMO_API FHexPathResult
+{
+	uint32 RequestId = 0;
+	uint32 GridVersion = 0;  // version du snapshot utilisé
+	bool   bFound = false;
+	int32  Cost = 0;         // coût jusqu'au but (le chemin renvoyé peut être tronqué au budget)
+	int32  NodesExpanded = 0;
+	TArray<FHexAxialCoordinates> Path;
+};
+
+DECLARE_DELEGATE_OneParam(FOnHexPathResult, const FHexPathResult& /*Result*/);
+
+/**
+ * Les chemins produits ici sont adjacents par construction (parents d'une recherche sur les voisins).
+ * Contrôle de debug uniquement : ensure au premier saut (pas non adjacent, ou attente si !bAllowWait).
+ * Retiré des builds Shipping via HEX_VALIDATE_PATH.
+ */
+DEMO_API bool ValidateHexPathAdjacency(TConstArrayView<FHexAxialCoordinates> Path, const TCHAR* Source, bool bAllowWait = false);
+
+#if !UE_BUILD_SHIPPING
+#define HEX_VALIDATE_PATH(Path, Source, bAllowWait) ValidateHexPathAdjacency(Path, Source, bAllowWait)
+#else
+#define HEX_VALIDATE_PATH(Path, Source, bAllowWait) ((void)0)
+#endif
+
+/** Poignée d'une requête en vol (annulation) */
+struct FHexPathRequestHandle
+{
+	uint32 Id = 0;
+	bool IsValid() const { return Id != 0; }
+};
+
+/**
+ * A* sur grille hex (doubled-q), voisins = tuiles réellement présentes.
+ * - Coût d'un pas = coût d'entrée de la tuile d'arrivée (grille), heuristique = distance * coût minimal
+ * - File de priorité = tas binaire (TArray::HeapPush/HeapPop)
+ * - État des noeuds dans un tableau dense indexé par UHexGridManager::GetTileIndex
+ * - Tampons conservés entre requêtes et « estampillés » par génération : rien n'est vidé,
+ *   aucune allocation par requête une fois les tampons dimensionnés
+ * - Service asynchrone : RequestPathAsync cherche sur un worker, sur un FHexGridSnapshot immuable,
+ *   et rappelle sur le game thread
+ */
 UCLASS(ClassGroup=(Hex), meta=(BlueprintSpawnableComponent))
 class DEMO_API UHexPathFinder : public UActorComponent
 {
@@ -16,25 +95,245 @@ class DEMO_API UHexPathFinder : public UActorComponent
 public:
 	UHexPathFinder();
 
-	/** À appeler au BeginPlay du GM : PathFinder->Init(GridManager); */
+	/** À appeler au BeginPlay du GM : PathFinder->Init(GridManager); (s'abonne à OnGridChanged) */
 	UFUNCTION(BlueprintCallable, Category="Hex|Path")
-	void Init(UHexGridManager* InGrid) { GridRef = InGrid; }
+	void Init(UHexGridManager* InGrid);
 
-	/** Trouve un chemin Start->Goal (Start et Goal inclus). Vide si impossible. */
+	/** Points de mouvement par tour : FindPath et l'arbre tronquent le chemin à ce budget ; <= 0 : pas de limite */
+	UPROPERTY(EditAnywhere, Category="Hex|Path")
+	int32 MovementBudget = 6;
+
+	/** Trouve un chemin Start->Goal (Start et Goal inclus), pondéré par les coûts de la grille. Vide si impossible. */
 	UFUNCTION(BlueprintCallable, Category="Hex|Path")
 	TArray<FHexAxialCoordinates> FindPath(const FHexAxialCoordinates& Start,
 	                                      const FHexAxialCoordinates& Goal);
 
+	/** Variante sans allocation : réutilise la capacité de OutPath. Renvoie false si aucun chemin. */
+	bool FindPathInto(const FHexAxialCoordinates& Start,
+	                  const FHexAxialCoordinates& Goal,
+	                  TArray<FHexAxialCoordinates>& OutPath);
+
+	/**
+	 * Arbre des plus courts chemins depuis Source (Dijkstra complet, une fois).
+	 * Reconstruit seulement si Source ou la version de la grille a changé ; renvoie false si Source n'existe pas.
+	 */
+	bool EnsurePathTree(const FHexAxialCoordinates& Source);
+
+	/** Chemin Source->Goal lu dans l'arbre en O(longueur), tronqué au budget comme FindPath. False si hors d'atteinte. */
+	bool GetTreePathTo(const FHexAxialCoordinates& Goal, TArray<FHexAxialCoordinates>& OutPath) const;
+
+	/** Coût depuis la source de l'arbre, INDEX_NONE si inatteignable */
+	int32 GetTreeCostTo(const FHexAxialCoordinates& Goal) const;
+
+	/** Oublie l'arbre (prochain EnsurePathTree = reconstruction) */
+	void InvalidatePathTree() { TreeSourceIndex = INDEX_NONE; }
+
+	/** Côté (en hex) des clusters de FindPathHierarchical */
+	UPROPERTY(EditAnywhere, Category="Hex|Path", meta=(ClampMin="2"))
+	int32 ClusterSize = 8;
+
+	/**
+	 * Variante hiérarchique (HPA*) pour les grandes grilles : A* sur le graphe des entrées de clusters,
+	 * puis raffinement des seuls segments couverts par MovementBudget. Presque optimal (une entrée par
+	 * segment de frontière). Graphe construit au premier appel, puis mis à jour par cluster.
+	 */
+	bool FindPathHierarchical(const FHexAxialCoordinates& Start, const FHexAxialCoordinates& Goal,
+	                          TArray<FHexAxialCoordinates>& OutPath);
+
+	/**
+	 * Champ de flux vers Targets : un seul Dijkstra multi-sources sur la grille dense (coûts de terrain).
+	 * Renvoie false si aucune cible n'existe (champ vide mais dimensionné).
+	 */
+	bool BuildFlowField(const TArray<FHexAxialCoordinates>& Targets, FHexFlowField& OutField);
+
+	/**
+	 * Une cible passe de From à To : ajoute To, retire From, et ne recalcule que les cases dont la valeur change
+	 * (celles qui passaient par From). Reconstruction complète si la grille a changé depuis le calcul.
+	 */
+	bool UpdateFlowFieldTargetMoved(FHexFlowField& Field, const FHexAxialCoordinates& From, const FHexAxialCoordinates& To);
+
+	/**
+	 * Portée de mouvement depuis Origin : Dijkstra borné par Rules.Profile.MovementBudget (coûts de terrain,
+	 * types interdits, cases bloquées, zones de contrôle). Le bitset remplace les BFS ad hoc ; false si
+	 * Origin n'est pas une tuile.
+	 */
+	bool ComputeMovementRange(const FHexAxialCoordinates& Origin, const FHexRangeRules& Rules, FHexMovementRange& OutRange);
+
+	/**
+	 * Validation d'un déplacement contre une portée déjà calculée : départ = origine, pas adjacents et
+	 * franchissables, aucun arrêt forcé (zone de contrôle) avant la fin, coût total <= budget.
+	 */
+	bool ValidateMove(const FHexMovementRange& Range, TConstArrayView<FHexAxialCoordinates> Path) const;
+
+	/**
+	 * Recherche Start->Goal sur un worker (snapshot de la grille au moment de l'appel).
+	 * OnResult est appelé sur le game thread, sauf si la requête a été annulée entre-temps.
+	 * Channel non vide : une nouvelle requête sur le même canal annule la précédente (ex. survol).
+	 */
+	FHexPathRequestHandle RequestPathAsync(const FHexAxialCoordinates& Start,
+	                                       const FHexAxialCoordinates& Goal,
+	                                       const FHexPathCostProfile& Profile,
+	                                       FOnHexPathResult OnResult,
+	                                       FName Channel = NAME_None);
+
+	/**
+	 * Planifie un lot d'agents ensemble (WHCA*, réservations espace-temps) sur un worker ; OnResult sur le game thread.
+	 * Ordre du lot = priorité. Window = horizon en pas (borné à FHexCooperativePlanner::MaxWindow) ;
+	 * MovementBudget s'applique à chaque agent. Plan.bFailed signale les agents sans plan sûr (chemin vide).
+	 */
+	FHexPathRequestHandle RequestCooperativePlanAsync(const TArray<FHexAgentMoveRequest>& Agents,
+	                                                  FOnHexCooperativePlan OnResult,
+	                                                  int32 Window = 16,
+	                                                  FName Channel = NAME_None);
+
+	/** Annule une requête (le worker s'arrête au prochain contrôle, le rappel est supprimé) */
+	void CancelPathRequest(FHexPathRequestHandle Handle);
+
+	int32 GetPendingPathRequestCount() const { return PendingRequests.Num(); }
+
+	/** Noeuds développés par la dernière recherche synchrone (FindPathInto, ComputeMovementRange) ; 0 si servie par le cache */
+	int32 GetLastNodesExpanded() const { return LastNodesExpanded; }
+
+	/** Tampons alloués ou agrandis par la dernière recherche synchrone (noeuds, tas, chemin ou portée, emplacement du
+	 *  cache) ; 0 en régime établi, cache compris. Un tampon agrandi plusieurs fois dans la même requête compte une fois. */
+	int32 GetLastBufferAllocations() const { return LastBufferAllocations; }
+
+	/** Taille max du cache LRU des chemins (Start, Goal, budget) ; 0 = désactivé */
+	UPROPERTY(EditAnywhere, Category="Hex|Path", meta=(ClampMin="0"))
+	int32 PathCacheCapacity = 256;
+
+	/** Compteurs du cache (FindPath + requêtes asynchrones sans restriction de profil) */
+	UFUNCTION(BlueprintPure, Category="Hex|Path")
+	void GetPathCacheStats(int32& OutHits, int32& OutMisses, int32& OutEntries) const;
+
+	UFUNCTION(BlueprintCallable, Category="Hex|Path")
+	void ResetPathCache();
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 private:
 	UPROPERTY() UHexGridManager* GridRef = nullptr;
+	FDelegateHandle GridChangedHandle;
+
+	/** Invalide le graphe hiérarchique (cluster de la tuile, ou tout si INDEX_NONE) */
+	void HandleGridChanged(int32 TileIndex);
+
+	/** Graphe HPA*, créé au premier FindPathHierarchical */
+	TSharedPtr<FHexClusterGraph> ClusterGraph;
+
+	/** État A* d'une tuile ; valide seulement si Generation == SearchGeneration */
+	struct FNodeRecord
+	{
+		int32  G = 0;
+		int32  Parent = INDEX_NONE;
+		uint32 Generation = 0;
+		bool   bClosed = false;
+	};
+
+	/** Entrée du tas ouvert (doublons tolérés, les entrées périmées sont ignorées au pop) */
+	struct FOpenEntry
+	{
+		int32 F;
+		int32 H;
+		int32 Index;
+	};
+
+	TArray<FNodeRecord> Nodes;
+	TArray<FOpenEntry>  OpenHeap;
+	TArray<int32>       RangeCostScratch;   // coûts d'une portée sans bKeepCosts
+	uint32              SearchGeneration = 0;
+	int32               LastNodesExpanded = 0;
+	int32               LastBufferAllocations = 0;
 
-	void GetValidNeighbors(const FHexAxialCoordinates& From,
-	                       TArray<FHexAxialCoordinates>& Out) const;
+	/** Dimensionne les tampons et ouvre une nouvelle génération */
+	void BeginSearch(int32 IndexCount);
 
 	int32 Heuristic(const FHexAxialCoordinates& A, const FHexAxialCoordinates& B) const;
 
-	static void ReconstructPath(const TMap<FHexAxialCoordinates,FHexAxialCoordinates>& Parent,
-	                            const FHexAxialCoordinates& Start,
-	                            const FHexAxialCoordinates& Goal,
-	                            TArray<FHexAxialCoordinates>& OutPath);
+	/** Remonte les parents depuis GoalIndex ; garde les noeuds de coût <= Budget (Budget <= 0 : tous) */
+	void ReconstructPath(int32 GoalIndex, int32 Budget, TArray<FHexAxialCoordinates>& OutPath) const;
+
+	/** Dijkstra (coût restant) depuis les entrées déjà dans OpenHeap ; relâchement strict uniquement */
+	void PropagateFlowField(FHexFlowField& Field);
+
+	/** Cases à recalculer lors d'un UpdateFlowFieldTargetMoved */
+	TArray<int32> FlowQueue;
+
+	// --- Arbre de plus courts chemins (aperçu au survol) ---
+	TArray<int32> TreeParent;   // INDEX_NONE = racine ou non atteint
+	TArray<int32> TreeCost;     // INDEX_NONE = non atteint
+	int32  TreeSourceIndex = INDEX_NONE;
+	uint32 TreeGridVersion = 0;
+
+	// --- Cache LRU des résultats (game thread uniquement) ---
+	struct FPathCacheKey
+	{
+		int32 Start = INDEX_NONE;
+		int32 Goal = INDEX_NONE;
+		int32 Budget = 0;
+
+		bool operator==(const FPathCacheKey& O) const { return Start == O.Start && Goal == O.Goal && Budget == O.Budget; }
+		friend uint32 GetTypeHash(const FPathCacheKey& K)
+		{
+			return HashCombineFast(HashCombineFast(uint32(K.Start), uint32(K.Goal)), uint32(K.Budget));
+		}
+	};
+
+	/** Emplacement du cache ; Path est un tampon recyclé d'une entrée expulsée à la suivante */
+	struct FCachedPath
+	{
+		FPathCacheKey Key;
+		bool  bFound = false;
+		int32 Cost = 0;
+		int32 Newer = INDEX_NONE;
+		int32 Older = INDEX_NONE;
+		TArray<FHexAxialCoordinates> Path;
+	};
+
+	/** LRU à capacité fixe : emplacements, index et tampons de chemin gardés d'une entrée à l'autre (pas d'allocation
+	 *  en régime établi). Toutes les entrées sont de CacheGridVersion : vidé dès que la grille change de version. */
+	TArray<FCachedPath>        PathCacheSlots;
+	TMap<FPathCacheKey, int32> PathCacheIndex;
+	int32  PathCacheNewest = INDEX_NONE;
+	int32  PathCacheOldest = INDEX_NONE;   // expulsé en premier
+	uint32 CacheGridVersion = 0;
+	int32  PathCacheHits = 0;
+	int32  PathCacheMisses = 0;
+
+	/** Vide le cache si la grille ou la capacité a changé ; false si le cache est désactivé */
+	bool SyncPathCache();
+	/** Vide les entrées sans rendre la mémoire des emplacements ni de l'index */
+	void ClearPathCache();
+	const FCachedPath* FindCachedPath(const FPathCacheKey& Key);
+	/** Copie le résultat dans l'emplacement libre ou le plus ancien ; renvoie 1 si son tampon a dû grandir */
+	int32 AddCachedPath(const FPathCacheKey& Key, bool bFound, int32 Cost, TConstArrayView<FHexAxialCoordinates> Path);
+	void UnlinkCachedPath(int32 Slot);
+	void LinkCachedPathAsNewest(int32 Slot);
+
+	// --- Requêtes asynchrones (game thread uniquement) ---
+	using FCancelFlag = TSharedRef<std::atomic<bool>, ESPMode::ThreadSafe>;
+
+	struct FPendingRequest
+	{
+		FCancelFlag   Cancelled;
+		FName         Channel;
+		FPathCacheKey CacheKey;   // Start == INDEX_NONE : résultat non mis en cache
+	};
+
+	TMap<uint32, FPendingRequest> PendingRequests;
+	uint32 NextRequestId = 0;
+
+	/** Nouvel identifiant ; annule d'abord la requête en vol sur le même canal */
+	uint32 BeginRequest(FName Channel);
+
+	/** Retire la requête de la table ; false si elle a été annulée ou remplacée (résultat à jeter) */
+	bool TakePendingRequest(uint32 RequestId, FPathCacheKey* OutCacheKey = nullptr);
+
+	void CompleteRequest(FHexPathResult&& Result, FOnHexPathResult&& OnResult);
+	void CompleteCooperativePlan(FHexCooperativePlan&& Plan, FOnHexCooperativePlan&& OnResult);
+
+	/** Recherche A* pondérée sur un snapshot ; thread-safe (tampons par thread) */
+	static void SearchSnapshot(const FHexGridSnapshot& Snap, int32 StartIdx, int32 GoalIdx,
+	                           const FHexPathCostProfile& Profile, const std::atomic<bool>& Cancelled,
+	                           FHexPathResult& Out);
 };
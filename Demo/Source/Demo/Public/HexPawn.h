@@ -15,6 +15,7 @@ class UHexSpriteComponent;
 class AHexTile;
 class UHexGridManager;
 class UCombatComponent;
+class FHexDStarLite;
 
 /**
  * Pawn that moves tile-to-tile on a hex grid and displays a Paper2D flipbook.
@@ -40,10 +41,28 @@ public:
     UFUNCTION(BlueprintCallable, Category="Hex|Move")
     void SetCurrentTile(AHexTile* NewTile);
 
-    /** Get current tile */
+    /** Get current tile (null when the grid renders instanced, use GetCurrentCoords) */
     UFUNCTION(BlueprintPure, Category="Hex|Move")
     AHexTile* GetCurrentTile() const { return CurrentTile; }
 
+    /**
+     * Set current cell by coordinates (no teleport unless done by caller).
+     * InGrid, when given, becomes the pawn's grid first, so CurrentTile resolves even before any move.
+     */
+    UFUNCTION(BlueprintCallable, Category="Hex|Move")
+    void SetCurrentCoords(const FHexAxialCoordinates& NewCoords, UHexGridManager* InGrid = nullptr);
+
+    /** Current cell; valid only when HasCurrentCoords() */
+    UFUNCTION(BlueprintPure, Category="Hex|Move")
+    FHexAxialCoordinates GetCurrentCoords() const { return CurrentCoords; }
+
+    UFUNCTION(BlueprintPure, Category="Hex|Move")
+    bool HasCurrentCoords() const { return bHasCurrentCoords; }
+
+    /** True while following a path */
+    UFUNCTION(BlueprintPure, Category="Hex|Move")
+    bool IsMoving() const { return bIsMoving; }
+
     /** Snap pawn to a start tile by axial coordinates */
     UFUNCTION(BlueprintCallable, Category="Hex|Move")
     void InitializePawnStartTile(const FHexAxialCoordinates& StartCoords);
@@ -64,6 +83,10 @@ public:
     UPROPERTY(EditAnywhere, Category="Hex|Move")
     bool bEaseInOut = true;
 
+    /** Repair the active path (D* Lite) from the current tile when the grid changes mid-move, instead of stopping */
+    UPROPERTY(EditAnywhere, Category="Hex|Move")
+    bool bRepairPathOnGridChange = true;
+
     /** Yaw turn rate when bFaceDirection = true */
     UPROPERTY(EditAnywhere, Category="Hex|Move", meta=(ClampMin="0.0"))
     float TurnRateDegPerSec = 720.f;
@@ -128,12 +151,42 @@ private:
     bool   bIsMoving = false;
     float  StepElapsed = 0.f;
 
+    /** Replanning state kept for the whole move (server only); the replanner is seeded on the first repair */
+    TSharedPtr<FHexDStarLite> Replanner;
+    FHexAxialCoordinates PathGoal;
+    bool   bReplannerSeeded = false;
+    uint32 PathGridVersion = 0;
+    int32  PathBudgetLeft = 0;
+
+    /** Entry cost of each CurrentPath cell when it was planned (or last checked) */
+    TArray<uint8> PathStepCosts;
+
+    /** Movement points the remaining path costs on the current grid */
+    int32 ComputeRemainingPathCost() const;
+
+    /** Snapshot the entry costs of CurrentPath into PathStepCosts */
+    void RecordPathStepCosts();
+
+    /**
+     * Grid changed since the path was planned. The path is kept unless a remaining step became impassable
+     * or dearer; then it is re-routed from CurrentCoords, and cut at the first zone of control tile.
+     * Paths with wait steps (cooperative plans) are never re-routed. False = no route, stop.
+     */
+    bool RepairPath();
+
+    /** End CurrentPath on the first remaining tile in the enemy zone of control */
+    void StopAtZoneOfControl();
+
     FVector StartLocation;
     FVector TargetLocation;
 
     UPROPERTY()
     AHexTile* CurrentTile = nullptr;
 
+    /** Authoritative cell, independent of tile actors */
+    FHexAxialCoordinates CurrentCoords;
+    bool bHasCurrentCoords = false;
+
     FVector LastReplicatedLocation;
     FVector SmoothLocation;
 
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+/**
+ * Mesures du sous-système hex, retirées des builds Shipping :
+ * - « stat Hex » : temps (cycle counters) et compteurs par frame / du dernier rebuild
+ * - Unreal Insights, canal « Hex » (-trace=cpu,hex) : scopes HEX_SCOPE, un événement Hex.Query par requête
+ *   et un Hex.Rebuild par génération de grille
+ */
+#define HEX_STATS_ENABLED (!UE_BUILD_SHIPPING)
+#define HEX_TRACE_ENABLED (HEX_STATS_ENABLED && UE_TRACE_ENABLED)
+
+DECLARE_STATS_GROUP(TEXT("Hex"), STATGROUP_Hex, STATCAT_Advanced);
+
+// --- Temps ---
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Grid rebuild"), STAT_HexGridRebuild, STATGROUP_Hex, DEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Grid rebuild: spawn"), STAT_HexGridSpawn, STATGROUP_Hex, DEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("FindPath"), STAT_HexFindPath, STATGROUP_Hex, DEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("FindPath (async)"), STAT_HexFindPathAsync, STATGROUP_Hex, DEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("FindPath (HPA*)"), STAT_HexFindPathHierarchical, STATGROUP_Hex, DEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Movement range"), STAT_HexMovementRange, STATGROUP_Hex, DEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Path tree"), STAT_HexPathTree, STATGROUP_Hex, DEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Flow field"), STAT_HexFlowField, STATGROUP_Hex, DEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Cooperative plan"), STAT_HexCooperativePlan, STATGROUP_Hex, DEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Path preview"), STAT_HexPreview, STATGROUP_Hex, DEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Cursor hover"), STAT_HexCursorHover, STATGROUP_Hex, DEMO_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Battle step"), STAT_HexBattleStep, STATGROUP_Hex, DEMO_API);
+
+// --- Par frame (remis à zéro à chaque frame) ---
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Path queries"), STAT_HexPathQueries, STATGROUP_Hex, DEMO_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Path cache hits"), STAT_HexPathCacheHits, STATGROUP_Hex, DEMO_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Nodes expanded"), STAT_HexNodesExpanded, STATGROUP_Hex, DEMO_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Path length"), STAT_HexPathLength, STATGROUP_Hex, DEMO_API);
+
+// --- Dernier rebuild ---
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Rebuild: tiles"), STAT_HexRebuildTiles, STATGROUP_Hex, DEMO_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Rebuild: ground traces"), STAT_HexRebuildTraces, STATGROUP_Hex, DEMO_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Rebuild: spawns"), STAT_HexRebuildSpawns, STATGROUP_Hex, DEMO_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Rebuild: duration (ms)"), STAT_HexRebuildMs, STATGROUP_Hex, DEMO_API);
+
+#if HEX_TRACE_ENABLED
+UE_TRACE_CHANNEL_EXTERN(HexChannel, DEMO_API);
+#define HEX_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(Name, HexChannel)
+#else
+#define HEX_TRACE_SCOPE(Name)
+#endif
+
+/** Temps de la portée dans « stat Hex » (Stat) et dans Insights sur le canal Hex (Name) ; une fois par portée */
+#define HEX_SCOPE(Stat, Name) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	HEX_TRACE_SCOPE(Name)
+
+/** Type de requête d'un événement Hex.Query */
+enum class EHexQueryKind : uint8
+{
+	FindPath,
+	FindPathAsync,
+	Hierarchical,
+	MovementRange,
+	PathTree,
+	FlowField,
+	Cooperative,
+};
+
+/** Une requête de chemin ou de portée */
+struct FHexQueryMetrics
+{
+	EHexQueryKind Kind = EHexQueryKind::FindPath;
+	int32 NodesExpanded = 0;
+	int32 PathLength = 0;     // cases du chemin (somme des agents en coopératif) ; cases atteintes pour une portée ; 0 arbre/flux
+	bool  bCacheHit = false;
+	bool  bFound = false;
+};
+
+/** Une génération de grille (traces, bake ou synthétique) */
+struct FHexRebuildMetrics
+{
+	int32  Tiles = 0;
+	int32  GroundTraces = 0;
+	int32  Spawned = 0;       // acteurs ou instances
+	bool   bFromBake = false;
+	double Seconds = 0.0;
+};
+
+namespace HexStats
+{
+#if HEX_STATS_ENABLED
+	/** Thread-safe : les workers asynchrones enregistrent leurs propres requêtes */
+	DEMO_API void RecordQuery(const FHexQueryMetrics& Metrics);
+	DEMO_API void RecordRebuild(const FHexRebuildMetrics& Metrics);
+#else
+	FORCEINLINE void RecordQuery(const FHexQueryMetrics&) {}
+	FORCEINLINE void RecordRebuild(const FHexRebuildMetrics&) {}
+#endif
+}